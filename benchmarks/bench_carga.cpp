@@ -0,0 +1,69 @@
+// Benchmark de carga: mede o tempo de carga e o da destruição do grafo em
+// cada estrutura, para um arquivo aleatório não direcionado, com o leitor
+// ifstream (carrega_grafo_stream), o leitor mapeado (carrega_grafo) e a
+// carga paralela (set_carga_paralela).
+//
+// Compilação:
+//   clang++ -O2 -pthread -o bench_carga benchmarks/bench_carga.cpp src/*.cpp
+// Uso:
+//   ./bench_carga [nVertices] [nArestas]
+
+#include "../include/Grafo.hpp"
+#include "../include/GrafoCSR.hpp"
+#include "../include/GrafoLista.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+using namespace std;
+
+static double ms_desde(chrono::steady_clock::time_point inicio) {
+  auto fim = chrono::steady_clock::now();
+  return chrono::duration<double, milli>(fim - inicio).count();
+}
+
+template <typename G>
+static void executa(const char *nome, const char *arquivo,
+                    const string &leitura) {
+  auto inicio = chrono::steady_clock::now();
+  G *g = new G();
+  g->set_carga_paralela(leitura == "paralela");
+  if (leitura == "stream")
+    g->carrega_grafo_stream(arquivo);
+  else
+    g->carrega_grafo(arquivo);
+  double carga = ms_desde(inicio);
+  int arestas = g->get_num_arestas();
+  inicio = chrono::steady_clock::now();
+  delete g;
+  double destruicao = ms_desde(inicio);
+  printf("%-8s %-9s %12.2f %14.2f %10d\n", nome, leitura.c_str(), carga,
+         destruicao, arestas);
+}
+
+int main(int argc, char *argv[]) {
+  int n = (argc > 1 ? atoi(argv[1]) : 20000);
+  int m = (argc > 2 ? atoi(argv[2]) : 1000000);
+  const char *arquivo = "bench_carga.tmp.txt";
+
+  srand(42);
+  ofstream saida(arquivo);
+  saida << n << " 0 0 0\n";
+  for (int i = 0; i < m; i++)
+    saida << (rand() % n + 1) << " " << (rand() % n + 1) << "\n";
+  saida.close();
+
+  // Laços e arestas repetidas sorteadas são descartados silenciosamente
+  streambuf *errAntigo = cerr.rdbuf(nullptr);
+  printf("%-8s %-9s %12s %14s %10s\n", "backend", "leitura", "carga_ms",
+         "destruicao_ms", "arestas");
+  const char *leituras[] = {"stream", "mmap", "paralela"};
+  for (int i = 0; i < 3; i++)
+    executa<GrafoLista>("lista", arquivo, leituras[i]);
+  for (int i = 0; i < 3; i++)
+    executa<GrafoCSR>("csr", arquivo, leituras[i]);
+  cerr.rdbuf(errAntigo);
+  remove(arquivo);
+  return 0;
+}
@@ -0,0 +1,156 @@
+// Benchmark dos cenários hipotéticos ("e se removermos este nó?"): cada
+// cenário remove um nó e a primeira aresta de outro e calcula o grau máximo
+// e o número de componentes. Compara a recarga do arquivo em uma GrafoLista
+// por cenário com clona() de uma GrafoVersionado carregada uma única vez.
+// Os N clones são mantidos vivos ao mesmo tempo, e a memória que eles somam
+// (contada pelo operator new deste programa) deve crescer com as alterações,
+// não com N vezes o tamanho do grafo. Os resultados dos dois modos devem ser
+// iguais e o grafo original não pode mudar; caso contrário o programa
+// termina com código 1.
+//
+// Compilação:
+//   clang++ -O2 -pthread -o bench_cenarios benchmarks/bench_cenarios.cpp src/*.cpp
+// Uso:
+//   ./bench_cenarios [nVertices] [arestasPorNo] [nCenarios]
+
+#include "../include/GeradorGrafos.hpp"
+#include "../include/GrafoLista.hpp"
+#include "../include/GrafoVersionado.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+using namespace std;
+
+// Bytes alocados ainda não liberados (substitui o operator new padrão; o
+// tamanho fica guardado antes do bloco)
+static atomic<long long> bytesVivos(0);
+static const size_t CABECALHO = 16;
+
+void *operator new(size_t tamanho) {
+  char *p = (char *)malloc(tamanho + CABECALHO);
+  if (!p)
+    throw bad_alloc();
+  *(size_t *)p = tamanho;
+  bytesVivos.fetch_add(tamanho, memory_order_relaxed);
+  return p + CABECALHO;
+}
+void operator delete(void *p) noexcept {
+  if (p == nullptr)
+    return;
+  char *bloco = (char *)p - CABECALHO;
+  bytesVivos.fetch_sub(*(size_t *)bloco, memory_order_relaxed);
+  free(bloco);
+}
+void operator delete(void *p, size_t) noexcept { operator delete(p); }
+
+static double ms_desde(chrono::steady_clock::time_point inicio) {
+  return chrono::duration<double, milli>(chrono::steady_clock::now() - inicio)
+      .count();
+}
+
+// Alterações de um cenário: remove o nó 'no' e depois a primeira aresta do
+// nó 'origem' (se houver), como o fluxo de main.cpp
+static void altera(Grafo &g, int no, int origem) {
+  g.deleta_no(no);
+  int destino = 0;
+  g.para_cada_vizinho(origem, [&](int w, int) {
+    destino = w;
+    return false;
+  });
+  if (destino != 0)
+    g.deleta_aresta(origem, destino);
+}
+
+int main(int argc, char *argv[]) {
+  int n = (argc > 1 ? atoi(argv[1]) : 20000);
+  int grau = (argc > 2 ? atoi(argv[2]) : 4);
+  int nCenarios = (argc > 3 ? atoi(argv[3]) : 200);
+  if (n < 3 || grau < 1 || nCenarios < 1) {
+    cerr << "Uso: " << argv[0] << " [nVertices] [arestasPorNo] [nCenarios]"
+         << endl;
+    return 1;
+  }
+  const char *arquivo = "bench_cenarios.tmp.txt";
+  GeradorGrafos gerador(42);
+  if (!gerador.salva(arquivo, GeradorGrafos::PREFERENCIAL, n, grau, false,
+                     true)) {
+    cerr << "Não foi possível escrever " << arquivo << endl;
+    return 1;
+  }
+  int *nos = new int[nCenarios];
+  int *origens = new int[nCenarios];
+  for (int i = 0; i < nCenarios; i++) {
+    nos[i] = gerador.inteiro(n) + 1;
+    origens[i] = gerador.inteiro(n - 1) + 1;
+  }
+  int *graus = new int[nCenarios];
+  int *componentes = new int[nCenarios];
+  long long falhas = 0;
+
+  // Recarga: um grafo carregado do arquivo por cenário
+  long long antes = bytesVivos;
+  long long bytesLista = 0;
+  auto inicio = chrono::steady_clock::now();
+  for (int i = 0; i < nCenarios; i++) {
+    GrafoLista g;
+    g.carrega_grafo(arquivo);
+    if (i == 0)
+      bytesLista = bytesVivos - antes;
+    altera(g, nos[i], origens[i]);
+    graus[i] = g.get_grau();
+    componentes[i] = g.n_conexo();
+  }
+  double msRecarga = ms_desde(inicio);
+
+  // Clones: a base é carregada uma vez e os N clones ficam vivos juntos
+  antes = bytesVivos;
+  GrafoVersionado base;
+  base.carrega_grafo(arquivo);
+  long long bytesBase = bytesVivos - antes;
+  int ordemBase = base.get_ordem();
+  int arestasBase = base.get_num_arestas();
+  GrafoVersionado **clones = new GrafoVersionado *[nCenarios];
+  antes = bytesVivos;
+  inicio = chrono::steady_clock::now();
+  for (int i = 0; i < nCenarios; i++) {
+    clones[i] = base.clona();
+    altera(*clones[i], nos[i], origens[i]);
+  }
+  double msClones = ms_desde(inicio);
+  long long bytesClones = bytesVivos - antes;
+  inicio = chrono::steady_clock::now();
+  for (int i = 0; i < nCenarios; i++) {
+    if (clones[i]->get_grau() != graus[i] ||
+        clones[i]->n_conexo() != componentes[i])
+      falhas++;
+    // As componentes calculadas ocupam O(V) por clone
+    delete clones[i];
+  }
+  double msConsultas = ms_desde(inicio);
+  if (base.get_ordem() != ordemBase || base.get_num_arestas() != arestasBase)
+    falhas++;
+
+  printf("%-10s %10s %14s %14s %16s\n", "modo", "cenarios", "ms_total",
+         "ms_cenario", "bytes_cenario");
+  printf("%-10s %10d %14.1f %14.3f %16lld\n", "recarga", nCenarios, msRecarga,
+         msRecarga / nCenarios, bytesLista);
+  printf("%-10s %10d %14.1f %14.3f %16lld\n", "clona", nCenarios,
+         msClones + msConsultas, (msClones + msConsultas) / nCenarios,
+         bytesClones / nCenarios);
+  printf("base: %lld bytes; %d clones vivos: %lld bytes (%.2f%% da base "
+         "por clone); clona + alterações: %.3f ms por cenário\n",
+         bytesBase, nCenarios, bytesClones,
+         100.0 * bytesClones / nCenarios / bytesBase, msClones / nCenarios);
+  printf("cenarios divergentes: %lld\n", falhas);
+
+  delete[] clones;
+  delete[] nos;
+  delete[] origens;
+  delete[] graus;
+  delete[] componentes;
+  remove(arquivo);
+  return (falhas > 0 ? 1 : 0);
+}
@@ -0,0 +1,196 @@
+// Benchmark (e teste de estresse) das consultas concorrentes com alterações:
+// uma thread escritora aplica nova_aresta, deleta_aresta, deleta_no e novo_no
+// sem parar enquanto L threads leitoras consultam o grafo (soma e máximo dos
+// graus, n_conexo). Cada leitura confere a consistência do que viu: a soma
+// dos graus é o dobro do número de arestas, toda aresta aparece nas duas
+// pontas e o número da versão nunca diminui. Compara a GrafoVersionado (cada
+// leitura em um InstantaneoGrafo, sem travas) com uma GrafoLista protegida
+// por um mutex, para L = 1, 2, 4... até o máximo pedido, informando as
+// leituras e as alterações por segundo. Termina com código 1 se alguma
+// leitura for inconsistente.
+//
+// Compilação:
+//   clang++ -O2 -pthread -o bench_instantaneos benchmarks/bench_instantaneos.cpp src/*.cpp
+// Uso:
+//   ./bench_instantaneos [nVertices] [arestasPorNo] [msPorRodada] [maxLeitores]
+
+#include "../include/GeradorGrafos.hpp"
+#include "../include/GrafoLista.hpp"
+#include "../include/GrafoVersionado.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+using namespace std;
+
+static atomic<bool> parar(false);
+static atomic<long long> leituras(0);
+static atomic<long long> alteracoes(0);
+static atomic<long long> falhas(0);
+
+static void falha(const char *motivo) {
+  if (falhas.fetch_add(1) < 10)
+    cerr << "Leitura inconsistente: " << motivo << endl;
+}
+
+// Consulta e confere um grafo que não muda durante a chamada
+static void le(Grafo &g, unsigned &semente) {
+  int n = g.get_ordem();
+  long long soma = 0;
+  for (int v = 1; v <= n; v++)
+    soma += g.get_grau_saida(v);
+  if (soma != 2LL * g.get_num_arestas())
+    falha("soma dos graus diferente de 2m");
+  for (int i = 0; i < 8 && n > 0; i++) {
+    int v = rand_r(&semente) % n + 1;
+    g.para_cada_vizinho(v, [&](int w, int peso) {
+      if (g.getPesoAresta(w, v) != peso)
+        falha("aresta sem a cópia reversa");
+      return true;
+    });
+  }
+  if (g.get_grau() < 0 || g.n_conexo() < (n > 0 ? 1 : 0))
+    falha("consulta inválida");
+}
+
+// Alteração sorteada, mantendo a ordem do grafo em torno da inicial
+static void altera(Grafo &g, unsigned &semente, int nInicial) {
+  int n = g.get_ordem();
+  int sorteio = rand_r(&semente) % 100;
+  int x = rand_r(&semente) % n + 1;
+  int y = rand_r(&semente) % n + 1;
+  if (sorteio < 45) {
+    if (x != y && g.getPesoAresta(x, y) >= 1e9)
+      g.nova_aresta(x, y, rand_r(&semente) % 100 + 1);
+  } else if (sorteio < 90) {
+    int destino = 0;
+    g.para_cada_vizinho(x, [&](int w, int) {
+      destino = w;
+      return false;
+    });
+    if (destino != 0)
+      g.deleta_aresta(x, destino);
+  } else if (sorteio < 95 && n > nInicial / 2) {
+    g.deleta_no(x);
+  } else {
+    g.novo_no(0);
+  }
+  alteracoes.fetch_add(1, memory_order_relaxed);
+}
+
+static void instantaneos(GrafoVersionado &g, int nInicial, int leitores,
+                         int ms) {
+  thread *threads = new thread[leitores];
+  for (int t = 0; t < leitores; t++)
+    threads[t] = thread([&g, t] {
+      unsigned semente = 1000 + t;
+      long long ultima = -1;
+      while (!parar.load(memory_order_relaxed)) {
+        InstantaneoGrafo instantaneo(g);
+        if (instantaneo.get_numero_versao() < ultima)
+          falha("versão anterior à já vista");
+        ultima = instantaneo.get_numero_versao();
+        le(instantaneo, semente);
+        leituras.fetch_add(1, memory_order_relaxed);
+      }
+    });
+  thread escritor([&g, nInicial] {
+    unsigned semente = 7;
+    while (!parar.load(memory_order_relaxed))
+      altera(g, semente, nInicial);
+  });
+  this_thread::sleep_for(chrono::milliseconds(ms));
+  parar = true;
+  escritor.join();
+  for (int t = 0; t < leitores; t++)
+    threads[t].join();
+  delete[] threads;
+  g.recupera();
+  if (g.get_versoes_retidas() != 0)
+    falha("versões retidas sem leitores");
+}
+
+static void com_trava(GrafoLista &g, int nInicial, int leitores, int ms) {
+  mutex trava;
+  thread *threads = new thread[leitores];
+  for (int t = 0; t < leitores; t++)
+    threads[t] = thread([&g, &trava, t] {
+      unsigned semente = 1000 + t;
+      while (!parar.load(memory_order_relaxed)) {
+        {
+          lock_guard<mutex> guarda(trava);
+          le(g, semente);
+        }
+        leituras.fetch_add(1, memory_order_relaxed);
+      }
+    });
+  thread escritor([&g, &trava, nInicial] {
+    unsigned semente = 7;
+    while (!parar.load(memory_order_relaxed)) {
+      lock_guard<mutex> guarda(trava);
+      altera(g, semente, nInicial);
+    }
+  });
+  this_thread::sleep_for(chrono::milliseconds(ms));
+  parar = true;
+  escritor.join();
+  for (int t = 0; t < leitores; t++)
+    threads[t].join();
+  delete[] threads;
+}
+
+int main(int argc, char *argv[]) {
+  int n = (argc > 1 ? atoi(argv[1]) : 20000);
+  int grau = (argc > 2 ? atoi(argv[2]) : 4);
+  int ms = (argc > 3 ? atoi(argv[3]) : 1000);
+  int maxLeitores = (argc > 4 ? atoi(argv[4]) : 8);
+  if (n < 2 || grau < 1 || ms < 1 || maxLeitores < 1) {
+    cerr << "Uso: " << argv[0]
+         << " [nVertices] [arestasPorNo] [msPorRodada] [maxLeitores]" << endl;
+    return 1;
+  }
+  const char *arquivo = "bench_instantaneos.tmp.txt";
+  GeradorGrafos gerador(42);
+  if (!gerador.salva(arquivo, GeradorGrafos::PREFERENCIAL, n, grau, false,
+                     true)) {
+    cerr << "Não foi possível escrever " << arquivo << endl;
+    return 1;
+  }
+
+  // Arestas repetidas e vértices inexistentes sorteados são recusados
+  streambuf *errAntigo = cerr.rdbuf(nullptr);
+  printf("%-12s %9s %14s %16s %18s\n", "modo", "leitores", "leituras/s",
+         "leituras/s/thr", "alteracoes/s");
+  for (int modo = 0; modo < 2; modo++) {
+    for (int leitores = 1; leitores <= maxLeitores; leitores *= 2) {
+      parar = false;
+      leituras = 0;
+      alteracoes = 0;
+      if (modo == 0) {
+        GrafoVersionado g;
+        g.carrega_grafo(arquivo);
+        cerr.rdbuf(errAntigo);
+        instantaneos(g, n, leitores, ms);
+        cerr.rdbuf(nullptr);
+      } else {
+        GrafoLista g;
+        g.carrega_grafo(arquivo);
+        cerr.rdbuf(errAntigo);
+        com_trava(g, n, leitores, ms);
+        cerr.rdbuf(nullptr);
+      }
+      double segundos = ms / 1000.0;
+      printf("%-12s %9d %14.1f %16.1f %18.1f\n",
+             modo == 0 ? "instantaneo" : "mutex", leitores,
+             leituras / segundos, leituras / segundos / leitores,
+             alteracoes / segundos);
+    }
+  }
+  cerr.rdbuf(errAntigo);
+  remove(arquivo);
+  printf("leituras inconsistentes: %lld\n", falhas.load());
+  return (falhas > 0 ? 1 : 0);
+}
@@ -0,0 +1,109 @@
+// Benchmark das remoções em lote: remove uma fração dos nós (e, em outra
+// cópia do grafo, das arestas) uma a uma, com deleta_no/deleta_aresta, e de
+// uma vez, com deleta_nos/deleta_arestas. Os dois modos devem terminar com o
+// mesmo número de nós e de arestas.
+//
+// Compilação:
+//   clang++ -O2 -pthread -o bench_lote benchmarks/bench_lote.cpp src/*.cpp
+// Uso:
+//   ./bench_lote [nVertices] [nArestas] [percentualRemovido]
+
+#include "../include/Grafo.hpp"
+#include "../include/GrafoCSR.hpp"
+#include "../include/GrafoLista.hpp"
+#include "../include/GrafoMatriz.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+using namespace std;
+
+static double ms_desde(chrono::steady_clock::time_point inicio) {
+  return chrono::duration<double, milli>(chrono::steady_clock::now() - inicio)
+      .count();
+}
+
+template <typename G>
+static void executa(const char *nome, const char *arquivo, int percentual) {
+  for (int lote = 0; lote < 2; lote++) {
+    // Remoção de nós: ids sorteados entre os que restam após as anteriores
+    G g;
+    g.carrega_grafo(arquivo);
+    int n = g.get_ordem();
+    int k = n * percentual / 100;
+    int *ids = new int[k];
+    srand(7);
+    for (int i = 0; i < k; i++)
+      ids[i] = rand() % (n - i) + 1;
+    auto inicio = chrono::steady_clock::now();
+    if (lote)
+      g.deleta_nos(ids, k);
+    else
+      for (int i = 0; i < k; i++)
+        g.deleta_no(ids[i]);
+    double msNos = ms_desde(inicio);
+    int ordem = g.get_ordem();
+    int arestasNos = g.get_num_arestas();
+    delete[] ids;
+
+    // Remoção de arestas existentes, tiradas da lista de vizinhos
+    G h;
+    h.carrega_grafo(arquivo);
+    int m = h.get_num_arestas() * percentual / 100;
+    int *origens = new int[m];
+    int *destinos = new int[m];
+    int nPares = 0;
+    srand(13);
+    while (nPares < m) {
+      int v = rand() % n + 1;
+      h.para_cada_vizinho(v, [&](int w, int) {
+        if (nPares < m && rand() % 4 == 0) {
+          origens[nPares] = v;
+          destinos[nPares] = w;
+          nPares++;
+        }
+        return true;
+      });
+    }
+    inicio = chrono::steady_clock::now();
+    if (lote)
+      h.deleta_arestas(origens, destinos, nPares);
+    else
+      for (int i = 0; i < nPares; i++)
+        h.deleta_aresta(origens[i], destinos[i]);
+    double msArestas = ms_desde(inicio);
+    delete[] origens;
+    delete[] destinos;
+
+    printf("%-8s %-10s %6d %12.2f %8d %8d %14.2f %10d\n", nome,
+           lote ? "lote" : "um_a_um", k, msNos, ordem, arestasNos, msArestas,
+           h.get_num_arestas());
+  }
+}
+
+int main(int argc, char *argv[]) {
+  int n = (argc > 1 ? atoi(argv[1]) : 2000);
+  int m = (argc > 2 ? atoi(argv[2]) : 40000);
+  int percentual = (argc > 3 ? atoi(argv[3]) : 20);
+  const char *arquivo = "bench_lote.tmp.txt";
+
+  srand(42);
+  ofstream saida(arquivo);
+  saida << n << " 1 0 1\n";
+  for (int i = 0; i < m; i++)
+    saida << (rand() % n + 1) << " " << (rand() % n + 1) << " "
+          << (rand() % 100 + 1) << "\n";
+  saida.close();
+
+  // Laços e arestas repetidas sorteadas são descartados silenciosamente
+  streambuf *errAntigo = cerr.rdbuf(nullptr);
+  printf("%-8s %-10s %6s %12s %8s %8s %14s %10s\n", "backend", "modo", "nos",
+         "ms_nos", "ordem", "arestas", "ms_arestas", "arestas");
+  executa<GrafoLista>("lista", arquivo, percentual);
+  executa<GrafoMatriz>("matriz", arquivo, percentual);
+  executa<GrafoCSR>("csr", arquivo, percentual);
+  cerr.rdbuf(errAntigo);
+  remove(arquivo);
+  return 0;
+}
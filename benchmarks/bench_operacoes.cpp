@@ -0,0 +1,350 @@
+// Benchmark das operações da biblioteca sobre grafos sintéticos (ver
+// GeradorGrafos): para cada tamanho, modelo e estrutura, mede carrega_grafo,
+// get_grau, n_conexo, eh_completo, calculaMaiorMenorDistancia, deleta_aresta
+// e deleta_no. Cada combinação é repetida (com o mesmo grafo) e o tempo
+// informado é a mediana. A saída em CSV ou JSON traz também o resultado de
+// cada consulta, para comparar versões da biblioteca com a mesma semente.
+//
+// Compilação:
+//   clang++ -O2 -pthread -o bench_operacoes benchmarks/bench_operacoes.cpp src/*.cpp
+// Uso:
+//   ./bench_operacoes [--tamanhos=100,300,1000] [--estruturas=lm]
+//                     [--repeticoes=3] [--semente=1] [--formato=csv|json]
+//                     [--saida=arquivo] [--direcionado] [--sem-pesos]
+//                     [--limite-distancia=1000]
+//   (estruturas: l = lista, m = matriz, c = CSR, b = matriz de bits,
+//    t = lista tipada, a = escolha automática entre lista e matriz,
+//    v = versionado; a distância não é medida acima de limite-distancia
+//    vértices)
+
+#include "../include/GeradorGrafos.hpp"
+#include "../include/Grafo.hpp"
+#include "../include/GrafoAdaptativo.hpp"
+#include "../include/GrafoBitMatriz.hpp"
+#include "../include/GrafoCSR.hpp"
+#include "../include/GrafoLista.hpp"
+#include "../include/GrafoMatriz.hpp"
+#include "../include/GrafoTipado.hpp"
+#include "../include/GrafoVersionado.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+using namespace std;
+
+// Operações medidas, na ordem em que são executadas sobre o mesmo grafo
+enum Operacao {
+  CARGA,
+  GRAU,
+  CONEXO,
+  COMPLETO,
+  DISTANCIA,
+  DELETA_ARESTA,
+  DELETA_NO,
+  N_OPERACOES
+};
+static const char *nomesOperacoes[N_OPERACOES] = {
+    "carrega_grafo", "get_grau", "n_conexo", "eh_completo",
+    "calculaMaiorMenorDistancia", "deleta_aresta", "deleta_no"};
+
+// Remoções medidas por repetição (o tempo informado é por remoção)
+const int REMOCOES = 10;
+
+struct Configuracao {
+  GeradorGrafos::Modelo modelo;
+  double parametro;
+};
+
+struct Saida {
+  FILE *f;
+  bool json;
+  int linhas;
+};
+
+static double ms_desde(chrono::steady_clock::time_point inicio) {
+  return chrono::duration<double, milli>(chrono::steady_clock::now() - inicio)
+      .count();
+}
+
+// A GrafoTipado é instanciada a partir do cabeçalho do arquivo
+static Grafo *cria(char estrutura, const char *arquivo) {
+  switch (estrutura) {
+  case 'l':
+    return new GrafoLista();
+  case 'm':
+    return new GrafoMatriz();
+  case 'c':
+    return new GrafoCSR();
+  case 'b':
+    return new GrafoBitMatriz();
+  case 't':
+    return cria_grafo_tipado(arquivo);
+  case 'a':
+    return new GrafoAdaptativo();
+  case 'v':
+    return new GrafoVersionado();
+  }
+  return nullptr;
+}
+
+static const char *nome_estrutura(char estrutura) {
+  switch (estrutura) {
+  case 'l':
+    return "lista";
+  case 'm':
+    return "matriz";
+  case 'c':
+    return "csr";
+  case 'b':
+    return "bitmatriz";
+  case 't':
+    return "tipado";
+  case 'a':
+    return "adaptativo";
+  case 'v':
+    return "versionado";
+  }
+  return "?";
+}
+
+static void escreve(Saida &saida, const char *estrutura, const char *modelo,
+                    double parametro, int n, int m, const char *operacao,
+                    double mediana, double minimo, double resultado,
+                    bool medido) {
+  if (saida.json) {
+    fprintf(saida.f,
+            "%s\n    {\"estrutura\": \"%s\", \"modelo\": \"%s\", "
+            "\"parametro\": %g, \"n\": %d, \"arestas\": %d, "
+            "\"operacao\": \"%s\", ",
+            saida.linhas > 0 ? "," : "", estrutura, modelo, parametro, n, m,
+            operacao);
+    if (medido)
+      fprintf(saida.f,
+              "\"ms_mediana\": %.4f, \"ms_minimo\": %.4f, \"resultado\": %g}",
+              mediana, minimo, resultado);
+    else
+      fprintf(saida.f,
+              "\"ms_mediana\": null, \"ms_minimo\": null, "
+              "\"resultado\": null}");
+  } else {
+    fprintf(saida.f, "%s,%s,%g,%d,%d,%s,", estrutura, modelo, parametro, n, m,
+            operacao);
+    if (medido)
+      fprintf(saida.f, "%.4f,%.4f,%g\n", mediana, minimo, resultado);
+    else
+      fprintf(saida.f, ",,\n");
+  }
+  saida.linhas++;
+}
+
+// Executa as operações 'repeticoes' vezes sobre o grafo de 'arquivo' e
+// escreve uma linha por operação
+static void mede(Saida &saida, char estrutura, const Configuracao &cfg,
+                 const GeradorGrafos::Arestas &arestas, const char *arquivo,
+                 int repeticoes, int limiteDistancia,
+                 unsigned long long semente) {
+  int n = arestas.n;
+  double *tempos = new double[N_OPERACOES * repeticoes];
+  double resultados[N_OPERACOES] = {0};
+  int m = 0;
+  bool medeDistancia = (n <= limiteDistancia);
+
+  for (int r = 0; r < repeticoes; r++) {
+    double *t = tempos + r * N_OPERACOES;
+    Grafo *g = cria(estrutura, arquivo);
+
+    auto inicio = chrono::steady_clock::now();
+    g->carrega_grafo(arquivo);
+    g->fim_carga();
+    t[CARGA] = ms_desde(inicio);
+    m = g->get_num_arestas();
+    resultados[CARGA] = g->get_ordem();
+
+    inicio = chrono::steady_clock::now();
+    resultados[GRAU] = g->get_grau();
+    t[GRAU] = ms_desde(inicio);
+
+    inicio = chrono::steady_clock::now();
+    resultados[CONEXO] = g->n_conexo();
+    t[CONEXO] = ms_desde(inicio);
+
+    inicio = chrono::steady_clock::now();
+    resultados[COMPLETO] = g->eh_completo();
+    t[COMPLETO] = ms_desde(inicio);
+
+    t[DISTANCIA] = 0;
+    if (medeDistancia) {
+      inicio = chrono::steady_clock::now();
+      resultados[DISTANCIA] = g->calculaMaiorMenorDistancia().distancia;
+      t[DISTANCIA] = ms_desde(inicio);
+    }
+
+    // Arestas e nós removidos são sorteados com a mesma semente em todas as
+    // repetições e estruturas; as arestas vêm do grafo gerado (os modelos
+    // não geram o mesmo par nos dois sentidos)
+    GeradorGrafos sorteio(semente);
+    int origens[REMOCOES], destinos[REMOCOES];
+    int indices[REMOCOES];
+    int nPares = (arestas.m < REMOCOES ? arestas.m : REMOCOES);
+    for (int i = 0; i < nPares; i++) {
+      bool repetido;
+      do {
+        indices[i] = sorteio.inteiro(arestas.m);
+        repetido = false;
+        for (int j = 0; j < i; j++)
+          repetido = repetido || (indices[j] == indices[i]);
+      } while (repetido);
+      origens[i] = arestas.origens[indices[i]];
+      destinos[i] = arestas.destinos[indices[i]];
+    }
+    inicio = chrono::steady_clock::now();
+    for (int i = 0; i < nPares; i++)
+      g->deleta_aresta(origens[i], destinos[i]);
+    t[DELETA_ARESTA] = (nPares > 0 ? ms_desde(inicio) / nPares : 0);
+    resultados[DELETA_ARESTA] = g->get_num_arestas();
+
+    int nos = (n / 2 < REMOCOES ? n / 2 : REMOCOES);
+    int ids[REMOCOES];
+    for (int i = 0; i < nos; i++)
+      ids[i] = sorteio.inteiro(n - i) + 1;
+    inicio = chrono::steady_clock::now();
+    for (int i = 0; i < nos; i++)
+      g->deleta_no(ids[i]);
+    g->compacta();
+    t[DELETA_NO] = (nos > 0 ? ms_desde(inicio) / nos : 0);
+    resultados[DELETA_NO] = g->get_num_arestas();
+
+    delete g;
+  }
+
+  double *amostra = new double[repeticoes];
+  for (int op = 0; op < N_OPERACOES; op++) {
+    for (int r = 0; r < repeticoes; r++)
+      amostra[r] = tempos[r * N_OPERACOES + op];
+    sort(amostra, amostra + repeticoes);
+    double mediana = (repeticoes % 2 ? amostra[repeticoes / 2]
+                                     : (amostra[repeticoes / 2 - 1] +
+                                        amostra[repeticoes / 2]) /
+                                           2);
+    escreve(saida, nome_estrutura(estrutura),
+            GeradorGrafos::nome_modelo(cfg.modelo), cfg.parametro, n, m,
+            nomesOperacoes[op], mediana, amostra[0], resultados[op],
+            op != DISTANCIA || medeDistancia);
+  }
+  delete[] amostra;
+  delete[] tempos;
+}
+
+int main(int argc, char *argv[]) {
+  int tamanhos[32] = {100, 300, 1000};
+  int nTamanhos = 3;
+  string estruturas = "lm";
+  int repeticoes = 3;
+  unsigned long long semente = 1;
+  bool json = false;
+  const char *nomeSaida = nullptr;
+  bool direcionado = false;
+  bool ponderado = true;
+  int limiteDistancia = 1000;
+
+  for (int i = 1; i < argc; i++) {
+    string opcao = argv[i];
+    if (opcao.compare(0, 11, "--tamanhos=") == 0) {
+      nTamanhos = 0;
+      for (const char *p = argv[i] + 11; *p && nTamanhos < 32;) {
+        tamanhos[nTamanhos++] = atoi(p);
+        p = strchr(p, ',');
+        if (p == nullptr)
+          break;
+        p++;
+      }
+    } else if (opcao.compare(0, 13, "--estruturas=") == 0)
+      estruturas = opcao.substr(13);
+    else if (opcao.compare(0, 13, "--repeticoes=") == 0)
+      repeticoes = max(1, atoi(argv[i] + 13));
+    else if (opcao.compare(0, 10, "--semente=") == 0)
+      semente = strtoull(argv[i] + 10, nullptr, 10);
+    else if (opcao == "--formato=json")
+      json = true;
+    else if (opcao == "--formato=csv")
+      json = false;
+    else if (opcao.compare(0, 8, "--saida=") == 0)
+      nomeSaida = argv[i] + 8;
+    else if (opcao == "--direcionado")
+      direcionado = true;
+    else if (opcao == "--sem-pesos")
+      ponderado = false;
+    else if (opcao.compare(0, 19, "--limite-distancia=") == 0)
+      limiteDistancia = atoi(argv[i] + 19);
+    else {
+      cerr << "Opção desconhecida: " << opcao << endl;
+      return 1;
+    }
+  }
+  for (char e : estruturas) {
+    if (strchr("lmcbtav", e) == nullptr) {
+      cerr << "Estrutura inválida: " << e << endl;
+      return 1;
+    }
+  }
+
+  // Erdős–Rényi em três densidades, grade, caminho, anexação preferencial
+  // com 3 arestas por nó novo e completo
+  const Configuracao configuracoes[] = {
+      {GeradorGrafos::ERDOS_RENYI, 0.01}, {GeradorGrafos::ERDOS_RENYI, 0.1},
+      {GeradorGrafos::ERDOS_RENYI, 0.5},  {GeradorGrafos::GRADE, 0},
+      {GeradorGrafos::CAMINHO, 0},        {GeradorGrafos::PREFERENCIAL, 3},
+      {GeradorGrafos::COMPLETO, 0}};
+
+  Saida saida = {stdout, json, 0};
+  if (nomeSaida != nullptr) {
+    saida.f = fopen(nomeSaida, "w");
+    if (saida.f == nullptr) {
+      cerr << "Erro ao criar " << nomeSaida << endl;
+      return 1;
+    }
+  }
+  if (json)
+    fprintf(saida.f,
+            "{\n  \"semente\": %llu,\n  \"repeticoes\": %d,\n  "
+            "\"direcionado\": %s,\n  \"ponderado\": %s,\n  \"resultados\": [",
+            semente, repeticoes, direcionado ? "true" : "false",
+            ponderado ? "true" : "false");
+  else
+    fprintf(saida.f, "estrutura,modelo,parametro,n,arestas,operacao,"
+                     "ms_mediana,ms_minimo,resultado\n");
+
+  const char *arquivo = "bench_operacoes.tmp.txt";
+  // Mensagens de erro da biblioteca (remoções de arestas já removidas por
+  // simetria, por exemplo) não fazem parte da saída
+  streambuf *errAntigo = cerr.rdbuf(nullptr);
+  for (int t = 0; t < nTamanhos; t++) {
+    int n = tamanhos[t];
+    for (const Configuracao &cfg : configuracoes) {
+      // O grafo de cada (tamanho, modelo) é o mesmo para todas as estruturas
+      GeradorGrafos gerador(semente + t);
+      GeradorGrafos::Arestas arestas;
+      gerador.gera(cfg.modelo, n, cfg.parametro, direcionado, arestas);
+      if (!GeradorGrafos::salva(arquivo, arestas, direcionado, ponderado)) {
+        cerr.rdbuf(errAntigo);
+        cerr << "Erro ao criar " << arquivo << endl;
+        return 1;
+      }
+      for (char e : estruturas)
+        mede(saida, e, cfg, arestas, arquivo, repeticoes, limiteDistancia,
+             semente + t);
+      fflush(saida.f);
+    }
+  }
+  cerr.rdbuf(errAntigo);
+  remove(arquivo);
+
+  if (json)
+    fprintf(saida.f, "\n  ]\n}\n");
+  if (saida.f != stdout)
+    fclose(saida.f);
+  return 0;
+}
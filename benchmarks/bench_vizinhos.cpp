@@ -0,0 +1,186 @@
+// Micro-benchmark da iteração de vizinhos: compara o número de alocações e o
+// tempo das consultas escritas sobre get_vizinhos (IntList) com as versões
+// atuais da classe base, que usam percorre_vizinhos. Também informa os bytes
+// que cada consulta deixa alocados (por exemplo, as componentes guardadas
+// por n_conexo).
+//
+// Compilação:
+//   clang++ -O2 -pthread -o bench_vizinhos benchmarks/bench_vizinhos.cpp src/*.cpp
+// Uso:
+//   ./bench_vizinhos [nVertices] [nArestas]
+
+#include "../include/Grafo.hpp"
+#include "../include/GrafoCSR.hpp"
+#include "../include/GrafoLista.hpp"
+#include "../include/GrafoMatriz.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+using namespace std;
+
+// Contadores globais de alocações e de bytes ainda não liberados
+// (substitui o operator new padrão; o tamanho fica guardado antes do bloco)
+static long long nAlocacoes = 0;
+static long long bytesVivos = 0;
+static const size_t CABECALHO = 16;
+
+void *operator new(size_t tamanho) {
+  nAlocacoes++;
+  char *p = (char *)malloc(tamanho + CABECALHO);
+  if (!p)
+    throw bad_alloc();
+  *(size_t *)p = tamanho;
+  bytesVivos += tamanho;
+  return p + CABECALHO;
+}
+void operator delete(void *p) noexcept {
+  if (p == nullptr)
+    return;
+  char *bloco = (char *)p - CABECALHO;
+  bytesVivos -= *(size_t *)bloco;
+  free(bloco);
+}
+void operator delete(void *p, size_t) noexcept { operator delete(p); }
+
+// Versões das consultas baseadas em get_vizinhos, como eram antes da API de
+// iteração
+static int grau_legado(const Grafo *g) {
+  int max_grau = 0;
+  for (int i = 1; i <= g->get_ordem(); i++) {
+    IntList vizinhos = g->get_vizinhos(i);
+    int in_deg = 0;
+    for (int j = 1; j <= g->get_ordem(); j++) {
+      if (j == i)
+        continue;
+      IntList viz = g->get_vizinhos(j);
+      for (int k = 0; k < viz.size(); k++) {
+        if (viz.get(k) == i) {
+          in_deg++;
+          break;
+        }
+      }
+    }
+    int total = vizinhos.size() + (g->eh_direcionado() ? in_deg : 0);
+    if (total > max_grau)
+      max_grau = total;
+  }
+  return max_grau;
+}
+
+static void dfs_legado(const Grafo *g, int v, bool *visitado) {
+  visitado[v] = true;
+  IntList viz = g->get_vizinhos(v);
+  for (int i = 0; i < viz.size(); i++) {
+    if (!visitado[viz.get(i)])
+      dfs_legado(g, viz.get(i), visitado);
+  }
+  for (int i = 1; i <= g->get_ordem(); i++) {
+    if (!visitado[i]) {
+      IntList viz_i = g->get_vizinhos(i);
+      for (int j = 0; j < viz_i.size(); j++) {
+        if (viz_i.get(j) == v) {
+          dfs_legado(g, i, visitado);
+          break;
+        }
+      }
+    }
+  }
+}
+
+static int conexo_legado(const Grafo *g) {
+  bool *visitado = new bool[g->get_ordem() + 1];
+  for (int i = 0; i <= g->get_ordem(); i++)
+    visitado[i] = false;
+  int count = 0;
+  for (int i = 1; i <= g->get_ordem(); i++) {
+    if (!visitado[i]) {
+      dfs_legado(g, i, visitado);
+      count++;
+    }
+  }
+  delete[] visitado;
+  return count;
+}
+
+static long long soma_vizinhos_legado(const Grafo *g) {
+  long long soma = 0;
+  for (int i = 1; i <= g->get_ordem(); i++) {
+    IntList viz = g->get_vizinhos(i);
+    for (int k = 0; k < viz.size(); k++)
+      soma += viz.get(k);
+  }
+  return soma;
+}
+
+static long long soma_vizinhos(const Grafo *g) {
+  long long soma = 0;
+  for (int i = 1; i <= g->get_ordem(); i++) {
+    g->para_cada_vizinho(i, [&soma](int destino, int) {
+      soma += destino;
+      return true;
+    });
+  }
+  return soma;
+}
+
+// Mede alocações, bytes retidos e tempo de uma consulta; o resultado é
+// impresso para evitar que o compilador elimine a chamada
+template <typename F>
+static void mede(const char *estrutura, const char *consulta, F f) {
+  long long antes = nAlocacoes;
+  long long vivosAntes = bytesVivos;
+  auto inicio = chrono::steady_clock::now();
+  long long resultado = f();
+  auto fim = chrono::steady_clock::now();
+  double ms = chrono::duration<double, milli>(fim - inicio).count();
+  printf("%-8s %-26s %12lld %14lld %10.2f %10lld\n", estrutura, consulta,
+         nAlocacoes - antes, bytesVivos - vivosAntes, ms, resultado);
+}
+
+int main(int argc, char *argv[]) {
+  int n = (argc > 1 ? atoi(argv[1]) : 300);
+  int m = (argc > 2 ? atoi(argv[2]) : 3000);
+  const char *arquivo = "bench_vizinhos.tmp.txt";
+
+  srand(42);
+  ofstream saida(arquivo);
+  saida << n << " 1 0 0\n";
+  for (int i = 0; i < m; i++)
+    saida << (rand() % n + 1) << " " << (rand() % n + 1) << "\n";
+  saida.close();
+
+  printf("%-8s %-26s %12s %14s %10s %10s\n", "backend", "consulta",
+         "alocacoes", "bytes_retidos", "tempo_ms", "resultado");
+  const char *nomes[] = {"matriz", "lista", "csr"};
+  for (int b = 0; b < 3; b++) {
+    Grafo *g = nullptr;
+    if (b == 0)
+      g = new GrafoMatriz();
+    else if (b == 1)
+      g = new GrafoLista();
+    else
+      g = new GrafoCSR();
+    // Os erros de laço/aresta repetida do arquivo aleatório são descartados
+    streambuf *errAntigo = cerr.rdbuf(nullptr);
+    g->carrega_grafo(arquivo);
+    cerr.rdbuf(errAntigo);
+
+    mede(nomes[b], "vizinhos (get_vizinhos)",
+         [g]() { return soma_vizinhos_legado(g); });
+    mede(nomes[b], "vizinhos (iteracao)", [g]() { return soma_vizinhos(g); });
+    mede(nomes[b], "get_grau (get_vizinhos)",
+         [g]() { return (long long)grau_legado(g); });
+    mede(nomes[b], "get_grau (iteracao)",
+         [g]() { return (long long)g->get_grau(); });
+    mede(nomes[b], "n_conexo (get_vizinhos)",
+         [g]() { return (long long)conexo_legado(g); });
+    mede(nomes[b], "n_conexo (iteracao)",
+         [g]() { return (long long)g->n_conexo(); });
+    delete g;
+  }
+  remove(arquivo);
+  return 0;
+}
@@ -0,0 +1,31 @@
+#ifndef ARQUIVOMAPEADO_HPP
+#define ARQUIVOMAPEADO_HPP
+
+#include <cstddef>
+#include <string>
+using namespace std;
+
+// Conteúdo de um arquivo, somente leitura, como um bloco contíguo de bytes.
+// Em sistemas POSIX o arquivo é mapeado na memória (mmap), sem cópia; nos
+// demais é lido de uma vez com fread.
+class ArquivoMapeado {
+private:
+  char *dados;
+  size_t nBytes;
+  bool mapeado; // true: dados vem de mmap; false: de new[]
+
+public:
+  ArquivoMapeado() : dados(nullptr), nBytes(0), mapeado(false) {}
+  ~ArquivoMapeado() { fecha(); }
+  ArquivoMapeado(const ArquivoMapeado &) = delete;
+  ArquivoMapeado &operator=(const ArquivoMapeado &) = delete;
+
+  // Retorna false se o arquivo não puder ser aberto ou lido
+  bool abre(const string &nomeArquivo);
+  void fecha();
+  const char *inicio() const { return dados; }
+  const char *fim() const { return dados + nBytes; }
+  size_t tamanho() const { return nBytes; }
+};
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef ARVOREFENWICK_HPP
+#define ARVOREFENWICK_HPP
+
+// Árvore de Fenwick sobre posições 1..tamanho(), cada uma valendo 0 ou 1
+// (posição viva ou removida). Permite saber quantas posições vivas existem
+// até uma posição e encontrar a k-ésima posição viva em O(log n).
+class ArvoreFenwick {
+private:
+  int *arvore;    // arvore[i] = soma das posições (i - lowbit(i), i]
+  bool *vivo;
+  int n;          // Número de posições
+  int capacidade; // Capacidade dos vetores
+  void resize(int novaCapacidade);
+
+public:
+  ArvoreFenwick();
+  ~ArvoreFenwick();
+  ArvoreFenwick(const ArvoreFenwick &) = delete;
+  ArvoreFenwick &operator=(const ArvoreFenwick &) = delete;
+
+  // Descarta o conteúdo e cria n posições vivas (O(n))
+  void reinicia(int n);
+  // Acrescenta uma posição viva ao final e retorna o seu índice
+  int adiciona();
+  // Marca a posição como removida (sem efeito se já estiver)
+  void remove(int posicao);
+  bool esta_viva(int posicao) const { return vivo[posicao]; }
+  // Número de posições vivas em 1..posicao
+  int prefixo(int posicao) const;
+  // Posição da k-ésima posição viva (k >= 1), ou -1 se não existir
+  int seleciona(int k) const;
+  int tamanho() const { return n; }
+};
+
+#endif
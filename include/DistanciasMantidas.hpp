@@ -0,0 +1,47 @@
+#ifndef DISTANCIASMANTIDAS_HPP
+#define DISTANCIASMANTIDAS_HPP
+
+struct MatrizDistancias;
+class PoolThreads;
+
+// Matriz de menores distâncias mantida entre consultas. Uma aresta nova (ou
+// um peso menor) (u, v, w) só pode encurtar caminhos que passem por ela, então
+// a matriz é atualizada em O(n²) com d[i][j] = min(d[i][j], d[i][u] + w +
+// d[v][j]). O maior valor finito de cada linha também é guardado (e só é
+// recalculado nas linhas alteradas), de modo que o par mais distante sai em
+// O(n), sem percorrer a matriz.
+class DistanciasMantidas {
+private:
+  MatrizDistancias *dist; // nullptr: inválida
+  int capacidade;         // linhas alocadas (dist->n <= capacidade)
+  double *maiorDaLinha;   // maior distância finita de cada linha (ou -1e9)
+  int *colunaDaMaior;     // coluna da primeira ocorrência (ou -1)
+  bool cicloNegativo;
+
+  void recalcula_linha(int i);
+
+public:
+  DistanciasMantidas();
+  ~DistanciasMantidas();
+  DistanciasMantidas(const DistanciasMantidas &) = delete;
+  DistanciasMantidas &operator=(const DistanciasMantidas &) = delete;
+
+  bool valida() const { return dist != nullptr; }
+  int ordem() const;
+  bool ciclo_negativo() const { return cicloNegativo; }
+  // Descarta a matriz (remoções, pesos maiores)
+  void invalida();
+  // Assume a matriz já resolvida (Floyd–Warshall) e calcula os máximos
+  void inicia(MatrizDistancias *calculada);
+  // Acrescenta um nó isolado ao final
+  void adiciona_no();
+  // Atualiza a matriz com a aresta origem -> destino (ids 1-based) de peso
+  // 'peso'; em grafos não direcionados, nos dois sentidos
+  void relaxa(int origem, int destino, double peso, bool direcionado,
+              PoolThreads &pool);
+  // Par (1-based) com a maior distância finita, com o mesmo desempate da
+  // varredura da matriz (primeiro na ordem das linhas); false se não há par
+  bool maior_distancia(int &no1, int &no2, double &distancia) const;
+};
+
+#endif
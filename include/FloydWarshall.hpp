@@ -0,0 +1,31 @@
+#ifndef FLOYDWARSHALL_HPP
+#define FLOYDWARSHALL_HPP
+
+#include "PoolThreads.hpp"
+
+// Matriz de distâncias n x n armazenada em um único bloco contíguo e alinhado:
+// a linha i começa em dados + i * passo. O passo é múltiplo do tamanho do
+// bloco usado pelo Floyd–Warshall blocado e as posições além de n (padding)
+// são preenchidas com INF (0 na diagonal), sem afetar o resultado.
+struct MatrizDistancias {
+  double *dados;
+  int n;
+  int passo;
+  MatrizDistancias(int n, double inf);
+  ~MatrizDistancias();
+  MatrizDistancias(const MatrizDistancias &) = delete;
+  MatrizDistancias &operator=(const MatrizDistancias &) = delete;
+  double *linha(int i) { return dados + (long long)i * passo; }
+  const double *linha(int i) const { return dados + (long long)i * passo; }
+};
+
+// Floyd–Warshall tradicional (laço triplo em uma única thread)
+void floyd_warshall_escalar(MatrizDistancias &dist);
+
+// Floyd–Warshall em blocos: em cada rodada k o bloco diagonal é resolvido
+// primeiro, depois os blocos da linha e da coluna k e por fim os demais; os
+// blocos de cada fase são independentes e distribuídos entre as threads do
+// pool. O laço interno (min-plus) usa instruções SIMD quando disponíveis.
+void floyd_warshall_blocado(MatrizDistancias &dist, PoolThreads &pool);
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef FORMATOBINARIO_HPP
+#define FORMATOBINARIO_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Formato binário de Grafo::salva_binario / carrega_binario. Os campos são
+// gravados na ordem de bytes da máquina (arquivos de outra ordem de bytes
+// são recusados) e cada seção começa em múltiplo de 8 bytes:
+//
+//   CabecalhoBinario
+//   pesosVertices[ordem]            int32
+//   offsets[ordem + 1]              int32, início da linha de cada nó
+//   destinos[nEntradas]             int32, 0-based, crescentes em cada linha
+//   pesos[nEntradas]                int32
+//   roffsets[ordem + 1]             (só em grafos direcionados) CSR reverso:
+//   rorigens[nEntradas]             origens das arestas que chegam a cada
+//   rpesos[nEntradas]               nó, crescentes em cada linha
+//
+// Em grafos não direcionados cada aresta aparece nas linhas dos dois
+// extremos. As seções têm o mesmo formato dos vetores da GrafoCSR, que pode
+// usá-las diretamente a partir do arquivo mapeado na memória.
+
+const char ASSINATURA_BINARIO[8] = {'G', 'R', 'A', 'F', 'O', 'B', 'I', 'N'};
+const uint32_t VERSAO_BINARIO = 1;
+const uint32_t MARCA_ORDEM_BYTES = 0x01020304;
+
+enum {
+  BINARIO_DIRECIONADO = 1,
+  BINARIO_PONDERADO_VERTICES = 2,
+  BINARIO_PONDERADO_ARESTAS = 4
+};
+
+struct CabecalhoBinario {
+  char assinatura[8];
+  uint32_t versao;
+  uint32_t marcaOrdemBytes; // MARCA_ORDEM_BYTES na ordem de quem gravou
+  uint32_t flags;           // BINARIO_*
+  int32_t ordem;
+  int64_t nEntradas;
+};
+
+// Posição (em bytes, a partir do início do arquivo) de cada seção
+struct LayoutBinario {
+  size_t pesosVertices, offsets, destinos, pesos;
+  size_t roffsets, rorigens, rpesos; // 0 em grafos não direcionados
+  size_t total;
+
+  LayoutBinario(int ordem, int nEntradas, bool direcionado) {
+    size_t pos = alinha(sizeof(CabecalhoBinario));
+    pesosVertices = pos;
+    pos = alinha(pos + sizeof(int32_t) * (size_t)ordem);
+    offsets = pos;
+    pos = alinha(pos + sizeof(int32_t) * ((size_t)ordem + 1));
+    destinos = pos;
+    pos = alinha(pos + sizeof(int32_t) * (size_t)nEntradas);
+    pesos = pos;
+    pos = alinha(pos + sizeof(int32_t) * (size_t)nEntradas);
+    roffsets = rorigens = rpesos = 0;
+    if (direcionado) {
+      roffsets = pos;
+      pos = alinha(pos + sizeof(int32_t) * ((size_t)ordem + 1));
+      rorigens = pos;
+      pos = alinha(pos + sizeof(int32_t) * (size_t)nEntradas);
+      rpesos = pos;
+      pos = alinha(pos + sizeof(int32_t) * (size_t)nEntradas);
+    }
+    total = pos;
+  }
+  static size_t alinha(size_t pos) { return (pos + 7) & ~(size_t)7; }
+};
+
+#endif
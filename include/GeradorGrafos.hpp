@@ -0,0 +1,80 @@
+#ifndef GERADORGRAFOS_HPP
+#define GERADORGRAFOS_HPP
+
+#include <string>
+using namespace std;
+
+// Geradores de grafos sintéticos com semente, para benchmarks e comparações
+// entre versões. A sequência pseudoaleatória (SplitMix64) é própria, de modo
+// que a mesma semente gera o mesmo grafo em qualquer plataforma. Os nós são
+// numerados de 1 a n, sem laços nem arestas repetidas, e os pesos das arestas
+// sorteados entre 1 e 100.
+class GeradorGrafos {
+public:
+  enum Modelo {
+    // G(n, p): cada par de nós é ligado com probabilidade 'parametro'
+    ERDOS_RENYI,
+    // Grade de ceil(sqrt(n)) colunas, ligando cada nó ao da direita e ao de
+    // baixo
+    GRADE,
+    // Caminho 1 - 2 - ... - n
+    CAMINHO,
+    // Anexação preferencial (Barabási–Albert): cada nó novo se liga a
+    // 'parametro' nós anteriores, sorteados com probabilidade proporcional
+    // ao grau (distribuição de graus em lei de potência)
+    PREFERENCIAL,
+    // Todos os pares
+    COMPLETO
+  };
+
+  // Arestas geradas (vetores de tamanho m, alocados com new[])
+  struct Arestas {
+    int n;
+    int m;
+    int *origens;
+    int *destinos;
+    int *pesos;
+    Arestas()
+        : n(0), m(0), origens(nullptr), destinos(nullptr), pesos(nullptr) {}
+    ~Arestas() {
+      delete[] origens;
+      delete[] destinos;
+      delete[] pesos;
+    }
+    Arestas(const Arestas &) = delete;
+    Arestas &operator=(const Arestas &) = delete;
+  };
+
+  explicit GeradorGrafos(unsigned long long semente);
+
+  // Sorteia as arestas do modelo em 'saida' (substituindo o conteúdo). Em
+  // grafos direcionados, Erdős–Rényi e o completo consideram os pares
+  // ordenados; nos demais modelos as arestas seguem a construção (para a
+  // direita e para baixo na grade, do nó novo para o antigo na anexação
+  // preferencial).
+  void gera(Modelo modelo, int n, double parametro, bool direcionado,
+            Arestas &saida);
+  // Gera o grafo e o grava no formato texto lido por carrega_grafo; false se
+  // o arquivo não pôde ser escrito
+  bool salva(const string &nomeArquivo, Modelo modelo, int n, double parametro,
+             bool direcionado, bool ponderado);
+  // Grava arestas já geradas
+  static bool salva(const string &nomeArquivo, const Arestas &arestas,
+                    bool direcionado, bool ponderado);
+
+  // Inteiro uniforme em [0, limite)
+  int inteiro(int limite);
+  // Real uniforme em [0, 1)
+  double uniforme();
+
+  static const char *nome_modelo(Modelo modelo);
+  // Aceita os nomes de nome_modelo (er, grade, caminho, preferencial,
+  // completo)
+  static bool modelo_por_nome(const string &nome, Modelo &modelo);
+
+private:
+  unsigned long long estado;
+  unsigned long long proximo();
+};
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef GERENCIADOREPOCAS_HPP
+#define GERENCIADOREPOCAS_HPP
+
+#include <atomic>
+#include <cstdint>
+
+// Reclamação de memória por épocas (no estilo do RCU), usada pelas versões da
+// GrafoVersionado. Um leitor ocupa uma vaga com a época atual enquanto lê
+// (entra/sai), sem travas e sem escrever nos objetos lidos. Quem retira um
+// objeto (depois de torná-lo inalcançável para novos leitores) avança a época
+// e guarda a anterior; o objeto pode ser liberado quando ela for menor que a
+// época de todos os leitores ativos (menor_ativa).
+class GerenciadorEpocas {
+public:
+  // Leitores simultâneos; com todas as vagas ocupadas, entra() espera
+  static const int MAX_LEITORES = 256;
+
+  GerenciadorEpocas();
+  GerenciadorEpocas(const GerenciadorEpocas &) = delete;
+  GerenciadorEpocas &operator=(const GerenciadorEpocas &) = delete;
+
+  // Registra um leitor na época atual e retorna a vaga ocupada, que deve ser
+  // devolvida a sai(). Os objetos lidos depois de entra() não são liberados
+  // até a saída.
+  int entra();
+  void sai(int vaga);
+  // Avança a época e retorna a anterior, que identifica os objetos retirados
+  // antes da chamada
+  uint64_t avanca();
+  // Menor época entre os leitores ativos (UINT64_MAX se não houver): os
+  // objetos retirados em épocas menores já podem ser liberados
+  uint64_t menor_ativa() const;
+
+  // Domínio compartilhado por todas as GrafoVersionado
+  static GerenciadorEpocas &global();
+
+private:
+  // Uma linha de cache por vaga, para que os leitores não disputem a mesma
+  // linha; 0 indica vaga livre
+  struct alignas(64) Vaga {
+    std::atomic<uint64_t> epoca;
+  };
+  alignas(64) std::atomic<uint64_t> epocaAtual;
+  // Maior vaga já ocupada + 1: menor_ativa() só percorre essas
+  std::atomic<int> vagasUsadas;
+  Vaga vagas[MAX_LEITORES];
+};
+
+#endif
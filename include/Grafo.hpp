@@ -1,20 +1,99 @@
 #ifndef GRAFO_HPP
 #define GRAFO_HPP
 
+#include "ArvoreFenwick.hpp"
+#include "DistanciasMantidas.hpp"
+#include "Instrumentacao.hpp"
 #include "IntList.hpp"
+#include "UniaoBusca.hpp"
+#include <cstdio>
+#include <iosfwd>
 #include <string>
 using namespace std;
 
+class ArquivoMapeado;
+struct CabecalhoBinario;
+struct MatrizDistancias;
+
+// Visitante usado por Grafo::percorre_vizinhos: visita() é chamada para cada
+// vizinho (destino e peso da aresta) e deve retornar false para interromper a
+// iteração.
+class VisitanteVizinhos {
+public:
+  virtual ~VisitanteVizinhos() {}
+  virtual bool visita(int destino, int peso) = 0;
+};
+
 class Grafo {
 protected:
   int ordem;              // número de vértices
   bool direcionado;       // true se direcionado, false caso contrário
   bool ponderadoVertices; // se os vértices têm peso
   bool ponderadoArestas;  // se as arestas têm peso
+
+  // Componentes conexas mantidas incrementalmente: cada inserção une os
+  // conjuntos dos extremos; remoções invalidam a estrutura, que é refeita na
+  // próxima chamada de n_conexo
+  mutable UniaoBusca componentes;
+  mutable bool componentesValidas;
+  // Matriz de distâncias mantida entre as consultas (set_distancias_mantidas)
+  bool manteDistancias;
+  mutable DistanciasMantidas distancias;
+  // Chamados pelas estruturas após cada inserção, alteração de peso ou
+  // remoção bem-sucedida; atualizam as componentes e as distâncias mantidas
+  void registra_vertice();
+  void registra_aresta(int origem, int destino, int peso);
+  void registra_peso(int origem, int destino, int pesoAntigo, int pesoNovo);
+  void registra_remocao();
+
+  // Arestas recusadas (laço, repetida, vértice inexistente): as estruturas
+  // chamam reporta_recusa() e só imprimem o motivo se ela retornar true.
+  // Durante carrega_grafo as mensagens são suprimidas e resumidas no final.
+  bool agrupaRecusas;
+  int arestasRecusadas;
+  bool cargaParalela;
+  int ordemMaximaFluxo;
+  bool reporta_recusa() {
+    arestasRecusadas++;
+    return !agrupaRecusas;
+  }
+  // Estruturas que guardam o grafo em outra instância (GrafoAdaptativo):
+  // copia_propriedades passa a ordem, a direção e os pesos de 'origem' para
+  // 'destino', e sincroniza_recusas faz 'interno' agrupar as recusas como
+  // 'externo', transferindo para 'externo' as que ele já contou
+  static void copia_propriedades(Grafo &destino, const Grafo &origem);
+  static void sincroniza_recusas(Grafo &externo, Grafo &interno);
+
+  // Remoção adiada: nós marcados como removidos desde a última compactação
+  // e posições internas (1-based) ainda vivas, para converter os ids
+  bool remocaoAdiada;
+  int removidosPendentes;
+  ArvoreFenwick posicoesVivas;
+  // Posição interna do nó com o id informado (o próprio id se não houver
+  // remoções pendentes), ou -1 se não existir
+  int posicao_do_id(int id) const;
+  // Aplica as remoções pendentes antes de uma operação que depende dos ids
+  void garante_compacto() const;
+  // Converte os ids de deleta_nos (cada um relativo ao grafo após as
+  // remoções anteriores do lote) nas posições 0-based de um grafo de n nós:
+  // removido[v] = true. Ids inválidos são informados em cerr, na ordem.
+  // Retorna o número de nós removidos.
+  static int marca_remocoes(const int *ids, int k, int n, bool *removido);
+
+  // Mapeia um arquivo binário e valida o cabeçalho, os offsets e os índices
+  // das arestas (no intervalo e crescentes em cada linha). Retorna o
+  // cabeçalho (dentro do mapeamento) ou nullptr, informando o erro em cerr.
+  static const CabecalhoBinario *abre_binario(ArquivoMapeado &arquivo,
+                                              const string &nomeArquivo);
+
 public:
   Grafo()
       : ordem(0), direcionado(false), ponderadoVertices(false),
-        ponderadoArestas(false) {}
+        ponderadoArestas(false), componentesValidas(true),
+        manteDistancias(false), agrupaRecusas(false), arestasRecusadas(0),
+        cargaParalela(false), ordemMaximaFluxo(ORDEM_MAXIMA_FLUXO_PADRAO),
+        remocaoAdiada(false), removidosPendentes(0),
+        modoDistancia(DISTANCIA_AUTOMATICA), varredurasDiametro(4) {}
   virtual ~Grafo() {}
 
   // Funções de acesso
@@ -23,37 +102,214 @@ public:
   bool vertice_ponderado() const { return ponderadoVertices; }
   bool aresta_ponderada() const { return ponderadoArestas; }
 
-  // Carrega o grafo a partir de um arquivo de texto
+  // Contadores de chamadas, tempo e bytes alocados por operação (ver
+  // Instrumentacao.hpp). São globais ao processo e ficam zerados se a
+  // biblioteca for compilada sem GRAFOS_INSTRUMENTACAO.
+  static EstatisticasGrafo estatisticas();
+  static void zera_estatisticas();
+
+  // Remoção adiada (tombstones): com o modo ativo, deleta_no apenas desliga
+  // o nó das suas arestas e o marca como removido, sem renumerar os demais.
+  // A renumeração é feita de uma só vez por compacta(), chamada
+  // automaticamente antes da próxima operação que dependa dos ids (vizinhos,
+  // pesos, inserções, distâncias...). get_ordem e get_num_arestas não exigem
+  // compactação. Com remoções pendentes, a primeira consulta altera a
+  // estrutura e não deve ser feita em paralelo com outras.
+  void set_remocao_adiada(bool ativa);
+  bool get_remocao_adiada() const { return remocaoAdiada; }
+  int get_removidos_pendentes() const { return removidosPendentes; }
+  // Aplica as remoções pendentes (sem efeito se não houver)
+  virtual void compacta() {}
+
+  // Carrega o grafo a partir de um arquivo de texto. O arquivo é mapeado na
+  // memória e lido por um analisador próprio; linhas de aresta malformadas
+  // e arestas recusadas são informadas em um único resumo no final.
   void carrega_grafo(const string &nomeArquivo);
+  // Leitura com ifstream, aresta a aresta (implementação original, mantida
+  // para comparação)
+  void carrega_grafo_stream(const string &nomeArquivo);
+  // Carga paralela: a seção de arestas é dividida em trechos alinhados a
+  // quebras de linha, lidos em paralelo pelo PoolThreads global, e as
+  // arestas são inseridas de uma só vez por inserir_arestas_lote, na ordem
+  // do arquivo. O grafo resultante é idêntico ao da carga sequencial.
+  void set_carga_paralela(bool ativa) { cargaParalela = ativa; }
+  bool get_carga_paralela() const { return cargaParalela; }
+  // Carga contínua: lê o formato de carrega_grafo de 'entrada' (por exemplo
+  // stdin) à medida que os dados chegam, usando só um buffer de tamanho fixo
+  // além do próprio grafo. O cabeçalho dá a ordem inicial (pode ser 0) e
+  // arestas com ids acima da ordem atual criam os nós que faltam (novo_no).
+  // A cada 'aCadaArestas' arestas lidas ou 'aCadaMs' milissegundos (0
+  // desativa cada critério) uma linha com as métricas é escrita em
+  // 'relatorio'; o grau máximo e as componentes são atualizados a cada
+  // aresta, sem recálculo. Na GrafoCSR as arestas ficam pendentes até o fim
+  // da entrada (sem reconstrução por aresta), e as repetidas só são
+  // descartadas no final. 'entrada' não deve ter sido lida por stdio antes.
+  // Linhas com ids menores que 1 ou acima da ordem máxima são contadas como
+  // malformadas. Retorna false se o cabeçalho for inválido (inclusive com
+  // ordem acima da máxima) ou a leitura falhar.
+  bool carrega_fluxo(FILE *entrada, ostream &relatorio, int aCadaArestas,
+                     int aCadaMs);
+  // Maior ordem que carrega_fluxo aceita criar, o que limita a memória usada
+  // por ids grandes vindos da entrada
+  static const int ORDEM_MAXIMA_FLUXO_PADRAO = 10000000;
+  void set_ordem_maxima_fluxo(int maxima) { ordemMaximaFluxo = maxima; }
+  int get_ordem_maxima_fluxo() const { return ordemMaximaFluxo; }
+  // Grava o grafo no formato binário descrito em FormatoBinario.hpp
+  bool salva_binario(const string &nomeArquivo) const;
+  // Carrega um grafo gravado por salva_binario; retorna false se o arquivo
+  // não puder ser lido ou não estiver no formato. A GrafoCSR usa os vetores
+  // do arquivo mapeado diretamente, sem cópia; as demais estruturas inserem
+  // os vértices e as arestas normalmente.
+  virtual bool carrega_binario(const string &nomeArquivo);
+  // Informa se o arquivo começa com a assinatura do formato binário
+  static bool eh_arquivo_binario(const string &nomeArquivo);
   // Retorna o grau (ou grau máximo) do grafo
   int get_grau() const;
-  // Retorna a quantidade de componentes conexas (desconsiderando a direção)
+  // Retorna a quantidade de componentes conexas (desconsiderando a direção).
+  // O(1) após inserções; após remoções, refaz a union-find em O(V+E).
   int n_conexo() const;
   // Informa se o grafo é completo
   bool eh_completo() const;
 
-  virtual IntList get_vizinhos(int vertice) const = 0;
+  // Percorre os vizinhos do vértice sem alocar memória
+  virtual void percorre_vizinhos(int vertice,
+                                 VisitanteVizinhos &visitante) const = 0;
+  // Atalho para percorre_vizinhos com uma função/lambda bool(int, int)
+  template <typename F> void para_cada_vizinho(int vertice, F funcao) const;
+  // Retorna o número de vizinhos (grau de saída) do vértice
+  virtual int get_grau_saida(int vertice) const;
+  // Retorna o número de arestas do grafo
+  virtual int get_num_arestas() const;
+  // Retorna o número de arestas que chegam ao vértice (grau de entrada)
+  virtual int get_grau_entrada(int vertice) const;
+  // Percorre os vértices que possuem aresta para 'vertice' (o visitante recebe
+  // a origem e o peso da aresta). Em grafos não direcionados coincide com
+  // percorre_vizinhos.
+  virtual void percorre_predecessores(int vertice,
+                                      VisitanteVizinhos &visitante) const;
+  template <typename F>
+  void para_cada_predecessor(int vertice, F funcao) const;
+  // Compatibilidade: copia os vizinhos para uma IntList
+  virtual IntList get_vizinhos(int vertice) const;
+  // Retorna o peso do vértice (0 se os vértices não forem ponderados)
+  virtual int get_peso_vertice(int vertice) const = 0;
   // Métodos virtuais para inserir vértices e arestas
   virtual void inserir_vertice(int id, int peso = 0) = 0;
   virtual void inserir_aresta(int origem, int destino, int peso = 0) = 0;
+  // Insere n arestas, com o mesmo resultado (inclusive as recusas) de n
+  // chamadas a inserir_aresta na ordem dada. As estruturas podem
+  // sobrescrever para validar o lote inteiro de uma vez.
+  virtual void inserir_arestas_lote(const int *origens, const int *destinos,
+                                    const int *pesos, int n);
+  // Chamado por carrega_grafo após ler o cabeçalho, antes de inserir os
+  // vértices: número de vértices e um limite superior para o número de
+  // arestas, para que a estrutura seja dimensionada de uma só vez
+  virtual void reserva(int nVertices, int nArestas) {
+    (void)nVertices;
+    (void)nArestas;
+  }
+  // Chamado por carrega_grafo após a leitura de todos os vértices e arestas
+  virtual void fim_carga() {}
 
   // Estrutura para armazenar o resultado da função de distância
   struct ResultadoDistancia {
     int no1;
     int no2;
     double distancia;
+    bool cicloNegativo; // true se há ciclo negativo (distâncias indefinidas)
   };
 
   // Nova função virtual para obter o peso de uma aresta entre dois nós.
   virtual double getPesoAresta(int origem, int destino) const = 0;
 
+  // Algoritmo usado por calculaMaiorMenorDistancia
+  enum ModoDistancia {
+    DISTANCIA_AUTOMATICA, // escolhe o algoritmo a partir do grafo
+    DISTANCIA_FW_ESCALAR, // Floyd–Warshall tradicional, em uma única thread
+    DISTANCIA_FW_BLOCADO, // Floyd–Warshall em blocos, SIMD e multithread
+    DISTANCIA_JOHNSON,    // Johnson: Bellman–Ford + Dijkstra por origem
+    // Os dois modos abaixo usam buscas em largura e só valem para grafos sem
+    // peso nas arestas (nos ponderados é usado o modo automático)
+    DISTANCIA_BFS_EXATO,     // diâmetro exato com limites (iFUB)
+    DISTANCIA_BFS_APROXIMADO // limite inferior com varreduras sucessivas
+  };
+  void set_modo_distancia(ModoDistancia modo) { modoDistancia = modo; }
+  ModoDistancia get_modo_distancia() const { return modoDistancia; }
+  // Número de buscas em largura do modo aproximado (padrão 4)
+  void set_varreduras_diametro(int n) { varredurasDiametro = n; }
+
+  // Busca em largura a partir de 'origem', seguindo as arestas ao contrário
+  // se 'reverso' for true. dist[v] (v = 1..ordem) deve valer -1 para todos
+  // os nós na entrada; recebe a distância de cada nó alcançado, e 'fila'
+  // recebe os nós alcançados em ordem não decrescente de distância. Retorna
+  // o número de nós alcançados.
+  virtual int busca_largura(int origem, int *dist, int *fila,
+                            bool reverso = false) const;
+
   // Função para calcular, entre todos os pares de nós, qual é o par que possui
   // a maior menor distância
   virtual ResultadoDistancia calculaMaiorMenorDistancia() const;
+  // Distâncias mantidas: com o modo ativo, calculaMaiorMenorDistancia guarda
+  // a matriz do Floyd–Warshall (independentemente de set_modo_distancia), e
+  // cada aresta inserida ou peso reduzido a atualiza em O(V²); a consulta
+  // seguinte custa O(V). Remoções e aumentos de peso descartam a matriz, que
+  // é recalculada na próxima consulta. Usa memória O(V²).
+  void set_distancias_mantidas(bool ativa);
+  bool get_distancias_mantidas() const { return manteDistancias; }
+  // Funções dinâmicas: novo_no acrescenta o nó ordem + 1
+  virtual void novo_no(int peso = 0) = 0;
+  virtual void nova_aresta(int origem, int destino, int peso) = 0;
+  // Altera o peso de uma aresta existente (nos dois sentidos, se o grafo não
+  // for direcionado)
+  virtual void altera_peso_aresta(int origem, int destino, int peso) = 0;
   virtual void deleta_no(int id) = 0;
   virtual void deleta_aresta(int origem, int destino) = 0;
+  // Remoções em lote, com o mesmo resultado de chamadas sucessivas na ordem
+  // dada (cada id de deleta_nos se refere ao grafo após as remoções
+  // anteriores do lote). Os nós são renumerados uma única vez; as
+  // estruturas podem sobrescrever para reescrever os vetores em uma só
+  // passada. A inserção em lote é inserir_arestas_lote.
+  virtual void deleta_nos(const int *ids, int k);
+  virtual void deleta_arestas(const int *origens, const int *destinos, int n);
+  // Cópia independente em O(1), para cenários hipotéticos (remover nós e
+  // arestas sem recarregar o original): compartilha a estrutura com este
+  // grafo, e cada um copia só as linhas que alterar depois. Só a
+  // GrafoVersionado e os seus instantâneos compartilham estrutura; as demais
+  // estruturas retornam nullptr (a GrafoVersionado pode ser construída a
+  // partir delas). A cópia é liberada com delete.
+  virtual Grafo *clona() const { return nullptr; }
 
   virtual void imprime_grafo() const = 0;
+
+protected:
+  ModoDistancia modoDistancia;
+  // Matriz de menores distâncias (Floyd–Warshall), alocada com new
+  MatrizDistancias *calcula_matriz_distancias(bool blocado) const;
+  ResultadoDistancia distancia_floyd_warshall(bool blocado) const;
+  ResultadoDistancia distancia_mantida() const;
+  ResultadoDistancia distancia_johnson() const;
+  int varredurasDiametro;
+  ResultadoDistancia distancia_bfs_exata() const;
+  ResultadoDistancia distancia_bfs_aproximada() const;
+};
+
+// Adapta uma função/lambda bool(int, int) para a interface VisitanteVizinhos
+template <typename F> struct AdaptadorVisitante : public VisitanteVizinhos {
+  F &f;
+  AdaptadorVisitante(F &f) : f(f) {}
+  bool visita(int destino, int peso) override { return f(destino, peso); }
 };
 
+template <typename F>
+void Grafo::para_cada_vizinho(int vertice, F funcao) const {
+  AdaptadorVisitante<F> adaptador(funcao);
+  percorre_vizinhos(vertice, adaptador);
+}
+
+template <typename F>
+void Grafo::para_cada_predecessor(int vertice, F funcao) const {
+  AdaptadorVisitante<F> adaptador(funcao);
+  percorre_predecessores(vertice, adaptador);
+}
+
 #endif
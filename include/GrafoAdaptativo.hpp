@@ -0,0 +1,102 @@
+#ifndef GRAFOADAPTATIVO_HPP
+#define GRAFOADAPTATIVO_HPP
+
+#include "Grafo.hpp"
+
+// Grafo que escolhe sozinho entre a GrafoLista (esparsos) e a GrafoMatriz
+// (densos) e guarda os dados em uma instância da estrutura escolhida, à qual
+// repassa as operações. A densidade é a fração das n² células da matriz que
+// estariam ocupadas (2 por aresta em grafos não direcionados).
+//
+// Na carga, a estrutura é escolhida em reserva() pela ordem e pelo limite de
+// arestas do cabeçalho e confirmada em fim_carga() com o número real de
+// arestas, comparando a densidade com a média geométrica dos dois limiares
+// (durante a carga só a migração para a matriz é possível). Depois, a cada
+// alteração (nova_aresta, deleta_aresta, novo_no, deleta_no, ...) a
+// densidade é reavaliada em O(1): o grafo migra para a matriz quando ela
+// atinge o limiar superior e volta para a lista quando cai abaixo do
+// inferior. A distância entre os limiares (histerese) impede que alterações
+// alternadas perto de um limiar provoquem migrações sucessivas e garante que
+// entre duas migrações haja Θ(n²) alterações, o que amortiza o custo de cada
+// uma (O(n²)).
+//
+// A ordem dos vizinhos é a da estrutura atual: crescente na matriz e, na
+// lista, a da GrafoLista (a migração da matriz para a lista preserva a ordem
+// crescente). Como a GrafoMatriz não representa arestas de peso 0, o grafo
+// não migra para a matriz enquanto houver alguma, e uma aresta de peso 0
+// inserida (ou um peso alterado para 0) com o grafo na matriz faz antes a
+// migração para a lista. O modo de remoção adiada não é repassado à
+// estrutura interna.
+class GrafoAdaptativo : public Grafo {
+public:
+  enum Representacao { LISTA, MATRIZ };
+
+private:
+  Grafo *interno;
+  Representacao representacao;
+  bool vazio;          // nenhum vértice inserido desde a criação
+  bool carregando;     // entre reserva e fim_carga
+  long long nArestas;  // arestas da estrutura interna
+  long long nPesoZero; // arestas de peso 0 (só existem na lista)
+  double limiarMatriz;
+  double limiarLista;
+  int migracoes;
+
+  static Grafo *cria(Representacao r);
+  double densidade() const;
+  // Copia o grafo para uma nova instância da representação 'r'
+  void migra(Representacao r);
+  // Migra se a densidade cruzou o limiar correspondente
+  void reavalia();
+  // Conta as arestas de peso 0 da estrutura interna em O(V + E)
+  long long conta_peso_zero() const;
+  // Volta para a lista antes de receber uma aresta de peso 0
+  void prepara_peso_zero();
+  bool existe_aresta(int origem, int destino) const;
+
+public:
+  GrafoAdaptativo();
+  virtual ~GrafoAdaptativo();
+  GrafoAdaptativo(const GrafoAdaptativo &) = delete;
+  GrafoAdaptativo &operator=(const GrafoAdaptativo &) = delete;
+
+  // Densidades (entre 0 e 1) de migração para a matriz e de volta para a
+  // lista; paraLista deve ser menor que paraMatriz (padrão 0,25 e 0,0625).
+  // Retorna false, sem alterar os limiares, se forem inválidos.
+  bool set_limiares(double paraMatriz, double paraLista);
+  Representacao get_representacao() const { return representacao; }
+  // Número de migrações desde a criação (as escolhas de reserva e
+  // fim_carga não contam)
+  int get_migracoes() const { return migracoes; }
+
+  virtual void inserir_vertice(int id, int peso = 0) override;
+  virtual void inserir_aresta(int origem, int destino, int peso = 0) override;
+  virtual void inserir_arestas_lote(const int *origens, const int *destinos,
+                                    const int *pesos, int n) override;
+  virtual void reserva(int nVertices, int nArestas) override;
+  virtual void fim_carga() override;
+  virtual void percorre_vizinhos(int vertice,
+                                 VisitanteVizinhos &visitante) const override;
+  virtual int get_grau_saida(int vertice) const override;
+  virtual int get_num_arestas() const override;
+  virtual int get_grau_entrada(int vertice) const override;
+  virtual void
+  percorre_predecessores(int vertice,
+                         VisitanteVizinhos &visitante) const override;
+  virtual int get_peso_vertice(int vertice) const override;
+  virtual double getPesoAresta(int origem, int destino) const override;
+  virtual int busca_largura(int origem, int *dist, int *fila,
+                            bool reverso = false) const override;
+
+  void novo_no(int peso = 0) override;
+  void nova_aresta(int origem, int destino, int peso) override;
+  void altera_peso_aresta(int origem, int destino, int peso) override;
+  void deleta_no(int id) override;
+  void deleta_aresta(int origem, int destino) override;
+  void deleta_nos(const int *ids, int k) override;
+  void deleta_arestas(const int *origens, const int *destinos,
+                      int n) override;
+  virtual void imprime_grafo() const override;
+};
+
+#endif
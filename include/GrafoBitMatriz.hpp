@@ -0,0 +1,66 @@
+#ifndef GRAFOBITMATRIZ_HPP
+#define GRAFOBITMATRIZ_HPP
+
+#include "Grafo.hpp"
+#include "IntList.hpp"
+#include <cstdint>
+
+// Matriz de adjacência compactada em bits, para grafos sem peso nas arestas:
+// cada linha ocupa 'palavras' palavras de 64 bits (um bit por coluna), 32
+// vezes menos memória que a GrafoMatriz. Graus e enumeração de vizinhos usam
+// popcount/ctz, e a busca em largura expande a fronteira palavra a palavra
+// (OU das linhas dos nós da fronteira). Em grafos direcionados a transposta
+// também é mantida, para predecessores e buscas reversas.
+class GrafoBitMatriz : public Grafo {
+private:
+  uint64_t *linhas;   // capacidade x palavras bits; bit j da linha i = (i, j)
+  uint64_t *colunas;  // transposta (apenas em grafos direcionados)
+  int *pesosVertices; // Vetor de pesos dos nós
+  int capacidade;     // Capacidade atual, em nós (múltiplo de 64)
+  int palavras;       // Palavras de 64 bits por linha (capacidade / 64)
+  int nNos;           // Número atual de nós inseridos
+
+  uint64_t *linha(int i) const { return linhas + (size_t)i * palavras; }
+  uint64_t *coluna(int i) const { return colunas + (size_t)i * palavras; }
+  bool tem_bit(int o, int d) const {
+    return (linha(o)[d >> 6] >> (d & 63)) & 1;
+  }
+  void realocarMatriz(int novaCapacidade);
+  // Liga ou desliga o bit (o, d), mantendo a transposta atualizada
+  void define_bit(int o, int d, bool valor);
+  int palavras_usadas() const { return (nNos + 63) / 64; }
+
+public:
+  GrafoBitMatriz();
+  virtual ~GrafoBitMatriz();
+  GrafoBitMatriz(const GrafoBitMatriz &) = delete;
+  GrafoBitMatriz &operator=(const GrafoBitMatriz &) = delete;
+
+  virtual void inserir_vertice(int id, int peso = 0) override;
+  virtual void inserir_aresta(int origem, int destino, int peso = 0) override;
+  virtual void reserva(int nVertices, int nArestas) override;
+  virtual void fim_carga() override;
+  virtual void percorre_vizinhos(int vertice,
+                                 VisitanteVizinhos &visitante) const override;
+  virtual int get_grau_saida(int vertice) const override;
+  virtual int get_num_arestas() const override;
+  virtual int get_grau_entrada(int vertice) const override;
+  virtual void
+  percorre_predecessores(int vertice,
+                         VisitanteVizinhos &visitante) const override;
+  virtual int get_peso_vertice(int vertice) const override;
+  virtual double getPesoAresta(int origem, int destino) const override;
+  virtual int busca_largura(int origem, int *dist, int *fila,
+                            bool reverso = false) const override;
+
+  // Funções dinâmicas:
+  void novo_no(int peso = 0) override;
+  void nova_aresta(int origem, int destino, int peso) override;
+  void altera_peso_aresta(int origem, int destino, int peso) override;
+  void deleta_no(int id) override;
+  void deleta_aresta(int origem, int destino) override;
+  void deleta_nos(const int *ids, int k) override;
+  virtual void imprime_grafo() const override;
+};
+
+#endif
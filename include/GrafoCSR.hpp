@@ -0,0 +1,93 @@
+#ifndef GRAFOCSR_HPP
+#define GRAFOCSR_HPP
+
+#include "Grafo.hpp"
+#include "ArquivoMapeado.hpp"
+#include "IntList.hpp"
+
+// Grafo armazenado em formato CSR (compressed sparse row): os vizinhos de
+// todos os vértices ficam em um único vetor contíguo, ordenados por destino
+// dentro de cada linha, e offsets[v]..offsets[v+1] delimitam a linha de v.
+// A estrutura é otimizada para consultas: cada alteração reconstrói os vetores
+// (O(V+E)) em vez de atualizá-los no local. Um grafo carregado de um arquivo
+// binário usa os vetores do arquivo mapeado até a primeira alteração.
+class GrafoCSR : public Grafo {
+private:
+  int nNos;           // Número atual de nós
+  int nLinhas;        // Linhas presentes em offsets (< nNos durante a carga)
+  int nEntradas;      // Número de entradas armazenadas (2 por aresta se não
+                      // direcionado)
+  int *offsets;       // Início da linha de cada nó (nNos + 1 posições)
+  int *destinos;      // Destino de cada entrada (índices 0-based)
+  int *pesos;         // Peso de cada entrada
+  int *pesosVertices; // Vetor de pesos dos nós
+  // CSR reverso (só em grafos direcionados): origens das arestas que chegam
+  // a cada nó
+  int *roffsets;
+  int *rorigens;
+  int *rpesos;
+  int capVertices;    // Capacidade do vetor de pesos dos nós
+  bool construido;    // false enquanto o grafo ainda está sendo carregado
+  // Arquivo binário do qual os vetores acima são lidos diretamente
+  // (carrega_binario), ou nullptr se os vetores são alocados pelo grafo
+  ArquivoMapeado *mapa;
+
+  // Arestas pendentes (inseridas desde a última reconstrução)
+  int *pendOrigem;
+  int *pendDestino;
+  int *pendPeso;
+  int nPendentes;
+  int capPendentes;
+
+  void adiciona_pendente(int origem, int destino, int peso);
+  void reserva_vertices(int novaCapacidade);
+  void reserva_pendentes(int novaCapacidade);
+  void libera_vetores();
+  // Copia os vetores mapeados para memória própria (antes de alterá-los)
+  void desvincula_mapa();
+  void constroi();
+  void constroi_reverso();
+  int busca_entrada(int o, int d) const;
+
+public:
+  GrafoCSR();
+  // Congela um grafo já existente (GrafoLista, GrafoMatriz, ...) em CSR
+  GrafoCSR(const Grafo &origem);
+  GrafoCSR(const GrafoCSR &origem)
+      : GrafoCSR(static_cast<const Grafo &>(origem)) {}
+  GrafoCSR &operator=(const GrafoCSR &) = delete;
+  virtual ~GrafoCSR();
+
+  virtual void inserir_vertice(int id, int peso = 0) override;
+  virtual void inserir_aresta(int origem, int destino, int peso = 0) override;
+  // Com o grafo construído, o lote inteiro é incorporado em uma única
+  // reconstrução
+  virtual void inserir_arestas_lote(const int *origens, const int *destinos,
+                                    const int *pesos, int n) override;
+  virtual bool carrega_binario(const string &nomeArquivo) override;
+  virtual void reserva(int nVertices, int nArestas) override;
+  virtual void fim_carga() override;
+  virtual void percorre_vizinhos(int vertice,
+                                 VisitanteVizinhos &visitante) const override;
+  virtual int get_grau_saida(int vertice) const override;
+  virtual int get_num_arestas() const override;
+  virtual int get_grau_entrada(int vertice) const override;
+  virtual void
+  percorre_predecessores(int vertice,
+                         VisitanteVizinhos &visitante) const override;
+  virtual int get_peso_vertice(int vertice) const override;
+  virtual double getPesoAresta(int origem, int destino) const override;
+
+  // Funções dinâmicas (cada uma reconstrói a estrutura):
+  void novo_no(int peso = 0) override;
+  void nova_aresta(int origem, int destino, int peso) override;
+  void altera_peso_aresta(int origem, int destino, int peso) override;
+  void deleta_no(int id) override;
+  void deleta_aresta(int origem, int destino) override;
+  void deleta_nos(const int *ids, int k) override;
+  void deleta_arestas(const int *origens, const int *destinos,
+                      int n) override;
+  virtual void imprime_grafo() const override;
+};
+
+#endif
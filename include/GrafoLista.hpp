@@ -16,29 +16,79 @@ struct Aresta {
 struct Vertice {
   int id;
   int peso;
+  int grauEntrada; // número de arestas que chegam ao vértice
   ListaEncadeada<Aresta> *arestas;
-  Vertice(int id, int peso) : id(id), peso(peso) {
-    arestas = new ListaEncadeada<Aresta>();
+  // Índice reverso (só alocado em grafos direcionados): cada Aresta guarda a
+  // origem de uma aresta que chega ao vértice
+  ListaEncadeada<Aresta> *predecessores;
+  Vertice(int id, int peso, ArenaNos<Aresta> *arena)
+      : id(id), peso(peso), grauEntrada(0), predecessores(nullptr) {
+    arestas = new ListaEncadeada<Aresta>(arena);
+  }
+  ~Vertice() {
+    delete arestas;
+    delete predecessores;
   }
-  ~Vertice() { delete arestas; }
 };
 
 class GrafoLista : public Grafo {
 private:
+  // Arenas dos nós de todas as listas do grafo: as listas de um mesmo grafo
+  // ocupam poucos blocos contíguos, liberados de uma vez no destrutor
+  ArenaNos<Aresta> arenaArestas;
+  ArenaNos<Vertice *> arenaVertices;
   ListaEncadeada<Vertice *> *vertices; // lista encadeada de vértices
+  // Índice denso: indice[id] aponta para o vértice com esse id (interno, se
+  // houver remoções pendentes), ou nullptr; posições 1..capIndice
+  Vertice **indice;
+  int capIndice;
+  // Limite superior do número de arestas (de grafos direcionados) para ids
+  // positivos que ainda não existiam na inserção
+  int arestasSemDestino;
+  void reserva_indice(int id);
+  // Atualizam o grau de entrada e o índice reverso de 'destino'
+  void registra_entrada(int origem, Vertice *destino, int peso);
+  void remove_entrada(int origem, Vertice *destino);
+  // Registra as arestas já existentes que apontam para o vértice recém
+  // criado e recalcula arestasSemDestino, em O(V + E)
+  void registra_entradas_pendentes(Vertice *novo);
+  void renumera_lista(ListaEncadeada<Aresta> *lista, const int *novoId,
+                      int n);
+  int remove_entradas(int *dono, int *alvo, int m, bool predecessores);
+
 public:
   GrafoLista();
   virtual ~GrafoLista();
+  GrafoLista(const GrafoLista &) = delete;
+  GrafoLista &operator=(const GrafoLista &) = delete;
   virtual void inserir_vertice(int id, int peso = 0) override;
   virtual void inserir_aresta(int origem, int destino, int peso = 0) override;
-  virtual IntList get_vizinhos(int vertice) const override;
-  // Função auxiliar para buscar um vértice pelo id
-  Vertice *encontrar_vertice(int id) const;
+  virtual void inserir_arestas_lote(const int *origens, const int *destinos,
+                                    const int *pesos, int n) override;
+  virtual void reserva(int nVertices, int nArestas) override;
+  virtual void percorre_vizinhos(int vertice,
+                                 VisitanteVizinhos &visitante) const override;
+  virtual int get_num_arestas() const override;
+  virtual int get_grau_entrada(int vertice) const override;
+  virtual void
+  percorre_predecessores(int vertice,
+                         VisitanteVizinhos &visitante) const override;
+  virtual int get_peso_vertice(int vertice) const override;
+  // Função auxiliar para buscar um vértice pelo id (interno, se houver
+  // remoções pendentes), em O(1)
+  Vertice *encontrar_vertice(int id) const {
+    CONTA_CHAMADA(OP_ENCONTRAR_VERTICE);
+    return (id >= 1 && id <= capIndice ? indice[id] : nullptr);
+  }
 
-  void novo_no(int peso = 0);
-  void nova_aresta(int origem, int destino, int peso);
+  void novo_no(int peso = 0) override;
+  void nova_aresta(int origem, int destino, int peso) override;
+  void altera_peso_aresta(int origem, int destino, int peso) override;
   void deleta_no(int id) override;
+  virtual void compacta() override;
   void deleta_aresta(int origem, int destino) override;
+  void deleta_arestas(const int *origens, const int *destinos,
+                      int n) override;
 
   virtual double getPesoAresta(int origem, int destino) const override;
 
@@ -4,27 +4,57 @@
 #include "Grafo.hpp"
 #include "IntList.hpp"
 
+// Matriz de adjacência armazenada em um único bloco contíguo e alinhado: a
+// linha i começa em matriz + i * passo. Todas as posições fora das nNos
+// primeiras linhas e colunas valem 0, de modo que um novo nó já encontra a
+// sua linha e a sua coluna zeradas.
 class GrafoMatriz : public Grafo {
 private:
   int *pesosVertices; // Vetor de pesos dos nós
-  int **matriz;       // Matriz de adjacência (capacidade x capacidade)
+  int *matriz;        // Matriz de adjacência (capacidade linhas de 'passo')
+  int passo;          // Distância entre linhas (capacidade arredondada)
+  int *grauSaida;     // Número de entradas não nulas em cada linha
+  int *grauEntrada;   // Número de entradas não nulas em cada coluna
   int capacidade;     // Capacidade atual (inicialmente 10)
   int nNos;           // Número atual de nós inseridos
+
+  int *linha(int i) const { return matriz + (size_t)i * passo; }
+  int celula(int o, int d) const { return linha(o)[d]; }
   void realocarMatriz(int novaCapacidade);
+  // Grava a célula (o, d), mantendo os contadores de grau atualizados
+  void define_celula(int o, int d, int valor);
 
 public:
   GrafoMatriz();
   virtual ~GrafoMatriz();
+  GrafoMatriz(const GrafoMatriz &) = delete;
+  GrafoMatriz &operator=(const GrafoMatriz &) = delete;
+
+  // Reduz a capacidade ao necessário para os nós atuais (a capacidade só
+  // cresce durante inserções e não diminui em deleta_no)
+  void reduz_capacidade();
+  int get_capacidade() const { return capacidade; }
 
   virtual void inserir_vertice(int id, int peso = 0) override;
   virtual void inserir_aresta(int origem, int destino, int peso = 0) override;
-  virtual IntList get_vizinhos(int vertice) const override;
+  virtual void reserva(int nVertices, int nArestas) override;
+  virtual void percorre_vizinhos(int vertice,
+                                 VisitanteVizinhos &visitante) const override;
+  virtual int get_grau_saida(int vertice) const override;
+  virtual int get_num_arestas() const override;
+  virtual int get_grau_entrada(int vertice) const override;
+  virtual void
+  percorre_predecessores(int vertice,
+                         VisitanteVizinhos &visitante) const override;
+  virtual int get_peso_vertice(int vertice) const override;
   virtual double getPesoAresta(int origem, int destino) const override;
 
   // Funções dinâmicas:
-  void novo_no(int peso = 0);
-  void nova_aresta(int origem, int destino, int peso);
+  void novo_no(int peso = 0) override;
+  void nova_aresta(int origem, int destino, int peso) override;
+  void altera_peso_aresta(int origem, int destino, int peso) override;
   void deleta_no(int id) override;
+  virtual void compacta() override;
   void deleta_aresta(int origem, int destino) override;
   virtual void imprime_grafo() const override;
 };
@@ -0,0 +1,179 @@
+#ifndef GRAFOTIPADO_HPP
+#define GRAFOTIPADO_HPP
+
+#include "Grafo.hpp"
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+// Grafo com as características fixadas em tempo de compilação: direção,
+// tipo do peso das arestas (SemPeso, int8_t, int16_t, int32_t ou float) e
+// presença de peso nos vértices. Cada combinação compila os seus próprios
+// laços, sem testar direcionado/ponderado a cada aresta, e os pesos ausentes
+// não ocupam memória: sem peso nas arestas, cada vizinho custa só o int do
+// destino. As listas de adjacência são vetores por vértice (destinos e pesos
+// em vetores separados, de modo que um peso int8_t não é alinhado a 4
+// bytes), com os vizinhos na ordem inversa de inserção, como na GrafoLista.
+// Em grafos direcionados cada vértice também guarda as origens das arestas
+// que chegam a ele.
+//
+// Arestas para vértices inexistentes e pesos fora do intervalo do tipo são
+// recusados. Sem peso nas arestas, todas valem 1. O modo de remoção adiada
+// não é usado (cada remoção renumera os nós em O(V+E); deleta_nos o faz uma
+// única vez para o lote).
+//
+// Normalmente o grafo é criado por cria_grafo_tipado, que escolhe a
+// instanciação a partir do cabeçalho do arquivo.
+
+struct SemPeso {};
+
+// Pesos das arestas de uma lista (política por tipo de peso)
+template <typename P> struct PesosLista {
+  P *pesos;
+  PesosLista() : pesos(nullptr) {}
+  int peso(int i) const { return (int)pesos[i]; }
+  void grava(int i, int p) { pesos[i] = (P)p; }
+  void move(int de, int para) { pesos[para] = pesos[de]; }
+  void realoca(int grau, int capacidade);
+  void libera() {
+    delete[] pesos;
+    pesos = nullptr;
+  }
+  void assume(PesosLista &outra) {
+    pesos = outra.pesos;
+    outra.pesos = nullptr;
+  }
+  static bool cabe(int p) {
+    return p >= std::numeric_limits<P>::lowest() &&
+           p <= std::numeric_limits<P>::max();
+  }
+};
+
+// Todo int cabe em int32_t; float guarda exatamente os inteiros de até 24
+// bits
+template <> inline bool PesosLista<int32_t>::cabe(int) { return true; }
+template <> inline bool PesosLista<float>::cabe(int p) {
+  return p >= -(1 << 24) && p <= (1 << 24);
+}
+
+template <> struct PesosLista<SemPeso> {
+  int peso(int) const { return 1; }
+  void grava(int, int) {}
+  void move(int, int) {}
+  void realoca(int, int) {}
+  void libera() {}
+  void assume(PesosLista &) {}
+  static bool cabe(int) { return true; }
+};
+
+// Vetores de destinos (ou origens) e pesos de um vértice
+template <typename P> struct ListaTipada : public PesosLista<P> {
+  int *destinos;
+  int grau;
+  int capacidade;
+
+  ListaTipada() : destinos(nullptr), grau(0), capacidade(0) {}
+  ~ListaTipada() { libera(); }
+  ListaTipada(const ListaTipada &) = delete;
+  ListaTipada &operator=(const ListaTipada &) = delete;
+
+  void adiciona(int destino, int peso);
+  // Índice da entrada com o destino, ou -1
+  int busca(int destino) const;
+  // Remove a entrada i, mantendo a ordem das demais
+  void remove_em(int i);
+  void libera();
+  // Toma os vetores de 'outra', que fica vazia (a lista deve estar vazia)
+  void assume(ListaTipada &outra);
+};
+
+// Pesos dos vértices (política pela presença de peso)
+template <bool PV> struct PesosVertices {
+  int *pesosVertices;
+  PesosVertices() : pesosVertices(nullptr) {}
+  ~PesosVertices() { delete[] pesosVertices; }
+  int peso_vertice(int i) const { return pesosVertices[i]; }
+  void grava_peso_vertice(int i, int p) { pesosVertices[i] = p; }
+  void realoca_pesos_vertices(int n, int capacidade);
+};
+
+template <> struct PesosVertices<false> {
+  int peso_vertice(int) const { return 0; }
+  void grava_peso_vertice(int, int) {}
+  void realoca_pesos_vertices(int, int) {}
+};
+
+template <bool Direcionado, typename PesoAresta, bool PesoVertice>
+class GrafoTipado : public Grafo, private PesosVertices<PesoVertice> {
+private:
+  typedef ListaTipada<PesoAresta> Lista;
+  Lista *saidas;   // saidas[v]: arestas que saem do nó v + 1
+  Lista *entradas; // só em grafos direcionados: origens das que chegam
+  int capacidade;  // listas alocadas
+  int nNos;        // número atual de nós
+
+  void garante_capacidade(int n);
+  // Remove os nós marcados (removido[v], v 0-based) e renumera os demais
+  // em uma única passada
+  void remove_marcados(const bool *removido);
+
+public:
+  GrafoTipado();
+  virtual ~GrafoTipado();
+  GrafoTipado(const GrafoTipado &) = delete;
+  GrafoTipado &operator=(const GrafoTipado &) = delete;
+
+  virtual void inserir_vertice(int id, int peso = 0) override;
+  virtual void inserir_aresta(int origem, int destino, int peso = 0) override;
+  virtual void reserva(int nVertices, int nArestas) override;
+  virtual void fim_carga() override;
+  virtual void percorre_vizinhos(int vertice,
+                                 VisitanteVizinhos &visitante) const override;
+  virtual int get_grau_saida(int vertice) const override;
+  virtual int get_num_arestas() const override;
+  virtual int get_grau_entrada(int vertice) const override;
+  virtual void
+  percorre_predecessores(int vertice,
+                         VisitanteVizinhos &visitante) const override;
+  virtual int get_peso_vertice(int vertice) const override;
+  virtual double getPesoAresta(int origem, int destino) const override;
+  virtual int busca_largura(int origem, int *dist, int *fila,
+                            bool reverso = false) const override;
+
+  void novo_no(int peso = 0) override;
+  void nova_aresta(int origem, int destino, int peso) override;
+  void altera_peso_aresta(int origem, int destino, int peso) override;
+  void deleta_no(int id) override;
+  void deleta_aresta(int origem, int destino) override;
+  void deleta_nos(const int *ids, int k) override;
+  virtual void imprime_grafo() const override;
+};
+
+// Tipo do peso das arestas na escolha da instanciação
+enum TipoPesoAresta {
+  PESO_AUTOMATICO, // int32_t se o arquivo tiver pesos nas arestas
+  PESO_NENHUM,
+  PESO_INT8,
+  PESO_INT16,
+  PESO_INT32,
+  PESO_FLOAT
+};
+
+// Nomes aceitos: auto, nenhum, int8, int16, int32, float
+bool tipo_peso_por_nome(const string &nome, TipoPesoAresta &tipo);
+const char *nome_tipo_peso(TipoPesoAresta tipo);
+
+// Cria a instanciação vazia correspondente (PESO_AUTOMATICO equivale a
+// PESO_INT32)
+Grafo *cria_grafo_tipado(bool direcionado, TipoPesoAresta tipo,
+                         bool pesoVertices);
+// Lê apenas o cabeçalho do arquivo (texto ou binário) e cria a instanciação
+// correspondente, ainda vazia: o grafo é carregado em seguida por
+// carrega_grafo ou carrega_binario. Retorna nullptr (com a mensagem em cerr)
+// se o cabeçalho não puder ser lido.
+Grafo *cria_grafo_tipado(const string &nomeArquivo,
+                         TipoPesoAresta tipo = PESO_AUTOMATICO);
+
+#include "GrafoTipado.tpp"
+#endif
@@ -0,0 +1,424 @@
+#include <iostream>
+
+template <typename P>
+void PesosLista<P>::realoca(int grau, int capacidade) {
+  P *novos = new P[capacidade];
+  for (int i = 0; i < grau; i++)
+    novos[i] = pesos[i];
+  delete[] pesos;
+  pesos = novos;
+}
+
+template <typename P> void ListaTipada<P>::adiciona(int destino, int peso) {
+  if (grau == capacidade) {
+    int novaCapacidade = (capacidade == 0 ? 4 : capacidade * 2);
+    REGISTRA_BYTES((long long)(sizeof(int) + sizeof(P)) *
+                   (novaCapacidade - capacidade));
+    int *novos = new int[novaCapacidade];
+    for (int i = 0; i < grau; i++)
+      novos[i] = destinos[i];
+    delete[] destinos;
+    destinos = novos;
+    PesosLista<P>::realoca(grau, novaCapacidade);
+    capacidade = novaCapacidade;
+  }
+  destinos[grau] = destino;
+  this->grava(grau, peso);
+  grau++;
+}
+
+template <typename P> int ListaTipada<P>::busca(int destino) const {
+  for (int i = 0; i < grau; i++) {
+    if (destinos[i] == destino)
+      return i;
+  }
+  return -1;
+}
+
+template <typename P> void ListaTipada<P>::remove_em(int i) {
+  for (int j = i + 1; j < grau; j++) {
+    destinos[j - 1] = destinos[j];
+    this->move(j, j - 1);
+  }
+  grau--;
+}
+
+template <typename P> void ListaTipada<P>::libera() {
+  delete[] destinos;
+  destinos = nullptr;
+  grau = capacidade = 0;
+  PesosLista<P>::libera();
+}
+
+template <typename P> void ListaTipada<P>::assume(ListaTipada &outra) {
+  libera();
+  destinos = outra.destinos;
+  grau = outra.grau;
+  capacidade = outra.capacidade;
+  PesosLista<P>::assume(outra);
+  outra.destinos = nullptr;
+  outra.grau = outra.capacidade = 0;
+}
+
+template <bool PV>
+void PesosVertices<PV>::realoca_pesos_vertices(int n, int capacidade) {
+  int *novos = new int[capacidade];
+  for (int i = 0; i < n; i++)
+    novos[i] = pesosVertices[i];
+  delete[] pesosVertices;
+  pesosVertices = novos;
+}
+
+template <bool D, typename P, bool PV>
+GrafoTipado<D, P, PV>::GrafoTipado()
+    : saidas(nullptr), entradas(nullptr), capacidade(0), nNos(0) {
+  direcionado = D;
+  ponderadoVertices = PV;
+  ponderadoArestas = !std::is_same<P, SemPeso>::value;
+}
+
+template <bool D, typename P, bool PV> GrafoTipado<D, P, PV>::~GrafoTipado() {
+  delete[] saidas;
+  delete[] entradas;
+}
+
+// A capacidade dobra quando necessário; as listas existentes são movidas
+// sem copiar os vetores de vizinhos
+template <bool D, typename P, bool PV>
+void GrafoTipado<D, P, PV>::garante_capacidade(int n) {
+  if (n <= capacidade)
+    return;
+  int novaCapacidade = (capacidade == 0 ? 16 : capacidade * 2);
+  if (novaCapacidade < n)
+    novaCapacidade = n;
+  REGISTRA_BYTES((long long)sizeof(Lista) * (D ? 2 : 1) *
+                 (novaCapacidade - capacidade));
+  Lista *novas = new Lista[novaCapacidade];
+  for (int v = 0; v < nNos; v++)
+    novas[v].assume(saidas[v]);
+  delete[] saidas;
+  saidas = novas;
+  if constexpr (D) {
+    novas = new Lista[novaCapacidade];
+    for (int v = 0; v < nNos; v++)
+      novas[v].assume(entradas[v]);
+    delete[] entradas;
+    entradas = novas;
+  }
+  this->realoca_pesos_vertices(nNos, novaCapacidade);
+  capacidade = novaCapacidade;
+}
+
+// O id é ignorado: o vértice recebe o próximo id (nNos + 1)
+template <bool D, typename P, bool PV>
+void GrafoTipado<D, P, PV>::inserir_vertice(int id, int peso) {
+  INSTRUMENTA(OP_INSERIR_VERTICE);
+  (void)id;
+  garante_capacidade(nNos + 1);
+  this->grava_peso_vertice(nNos, peso);
+  nNos++;
+  registra_vertice();
+}
+
+template <bool D, typename P, bool PV>
+void GrafoTipado<D, P, PV>::inserir_aresta(int origem, int destino,
+                                           int peso) {
+  INSTRUMENTA(OP_INSERIR_ARESTA);
+  if (origem == destino) {
+    if (reporta_recusa())
+      cerr << "Erro: Laço não permitido (origem e destino iguais: " << origem
+           << ")." << endl;
+    return;
+  }
+  int invalido = (origem < 1 || origem > nNos ? origem : destino);
+  if (invalido < 1 || invalido > nNos) {
+    if (reporta_recusa())
+      cerr << "Erro: Vértice " << invalido << " não encontrado." << endl;
+    return;
+  }
+  if (!Lista::cabe(peso)) {
+    if (reporta_recusa())
+      cerr << "Erro: Peso " << peso << " fora do intervalo do tipo das "
+           << "arestas." << endl;
+    return;
+  }
+  Lista &saida = saidas[origem - 1];
+  if (saida.busca(destino) >= 0) {
+    if (reporta_recusa())
+      cerr << "Erro: Aresta de " << origem << " para " << destino
+           << " já existe." << endl;
+    return;
+  }
+  saida.adiciona(destino, peso);
+  if constexpr (D)
+    entradas[destino - 1].adiciona(origem, peso);
+  else
+    saidas[destino - 1].adiciona(origem, peso);
+  registra_aresta(origem, destino, saida.peso(saida.grau - 1));
+}
+
+// Os pesos vêm do cabeçalho do arquivo; direção e peso dos vértices são os
+// da instanciação
+template <bool D, typename P, bool PV>
+void GrafoTipado<D, P, PV>::reserva(int nVertices, int nArestas) {
+  (void)nArestas;
+  if (direcionado != D)
+    cerr << "Aviso: grafo " << (D ? "direcionado" : "não direcionado")
+         << " carregado de um arquivo " << (D ? "não " : "")
+         << "direcionado; a direção do arquivo foi ignorada.\n";
+  direcionado = D;
+  ponderadoVertices = PV;
+  garante_capacidade(nVertices);
+}
+
+template <bool D, typename P, bool PV>
+void GrafoTipado<D, P, PV>::fim_carga() {
+  if (std::is_same<P, SemPeso>::value && ponderadoArestas)
+    cerr << "Aviso: GrafoTipado sem pesos nas arestas; todas as arestas são "
+            "tratadas com peso 1.\n";
+}
+
+template <bool D, typename P, bool PV>
+void GrafoTipado<D, P, PV>::percorre_vizinhos(
+    int vertice, VisitanteVizinhos &visitante) const {
+  if (vertice < 1 || vertice > nNos)
+    return;
+  const Lista &l = saidas[vertice - 1];
+  for (int i = l.grau - 1; i >= 0; i--) {
+    if (!visitante.visita(l.destinos[i], l.peso(i)))
+      return;
+  }
+}
+
+template <bool D, typename P, bool PV>
+int GrafoTipado<D, P, PV>::get_grau_saida(int vertice) const {
+  if (vertice < 1 || vertice > nNos)
+    return 0;
+  return saidas[vertice - 1].grau;
+}
+
+template <bool D, typename P, bool PV>
+int GrafoTipado<D, P, PV>::get_num_arestas() const {
+  long long total = 0;
+  for (int v = 0; v < nNos; v++)
+    total += saidas[v].grau;
+  return (int)(D ? total : total / 2);
+}
+
+template <bool D, typename P, bool PV>
+int GrafoTipado<D, P, PV>::get_grau_entrada(int vertice) const {
+  if (vertice < 1 || vertice > nNos)
+    return 0;
+  if constexpr (D)
+    return entradas[vertice - 1].grau;
+  else
+    return saidas[vertice - 1].grau;
+}
+
+template <bool D, typename P, bool PV>
+void GrafoTipado<D, P, PV>::percorre_predecessores(
+    int vertice, VisitanteVizinhos &visitante) const {
+  if constexpr (!D) {
+    percorre_vizinhos(vertice, visitante);
+  } else {
+    if (vertice < 1 || vertice > nNos)
+      return;
+    const Lista &l = entradas[vertice - 1];
+    for (int i = l.grau - 1; i >= 0; i--) {
+      if (!visitante.visita(l.destinos[i], l.peso(i)))
+        return;
+    }
+  }
+}
+
+template <bool D, typename P, bool PV>
+int GrafoTipado<D, P, PV>::get_peso_vertice(int vertice) const {
+  if (vertice < 1 || vertice > nNos)
+    return 0;
+  return this->peso_vertice(vertice - 1);
+}
+
+template <bool D, typename P, bool PV>
+double GrafoTipado<D, P, PV>::getPesoAresta(int origem, int destino) const {
+  CONTA_CHAMADA(OP_GET_PESO_ARESTA);
+  if (origem < 1 || origem > nNos)
+    return 1e9;
+  const Lista &l = saidas[origem - 1];
+  int i = l.busca(destino);
+  return (i < 0 ? 1e9 : l.peso(i));
+}
+
+// Mesma ordem de visita da busca genérica, sem o visitante virtual
+template <bool D, typename P, bool PV>
+int GrafoTipado<D, P, PV>::busca_largura(int origem, int *dist, int *fila,
+                                         bool reverso) const {
+  const Lista *listas = saidas;
+  if constexpr (D) {
+    if (reverso)
+      listas = entradas;
+  }
+  int ini = 0, fim = 0;
+  dist[origem] = 0;
+  fila[fim++] = origem;
+  while (ini < fim) {
+    int v = fila[ini++];
+    int proxima = dist[v] + 1;
+    const int *destinos = listas[v - 1].destinos;
+    for (int i = listas[v - 1].grau - 1; i >= 0; i--) {
+      int w = destinos[i];
+      if (dist[w] < 0) {
+        dist[w] = proxima;
+        fila[fim++] = w;
+      }
+    }
+  }
+  return fim;
+}
+
+template <bool D, typename P, bool PV>
+void GrafoTipado<D, P, PV>::novo_no(int peso) {
+  INSTRUMENTA(OP_NOVO_NO);
+  inserir_vertice(nNos + 1, peso);
+  ordem++;
+}
+
+template <bool D, typename P, bool PV>
+void GrafoTipado<D, P, PV>::nova_aresta(int origem, int destino, int peso) {
+  INSTRUMENTA(OP_NOVA_ARESTA);
+  inserir_aresta(origem, destino, peso);
+}
+
+template <bool D, typename P, bool PV>
+void GrafoTipado<D, P, PV>::altera_peso_aresta(int origem, int destino,
+                                               int peso) {
+  INSTRUMENTA(OP_ALTERA_PESO_ARESTA);
+  if constexpr (std::is_same<P, SemPeso>::value) {
+    (void)origem;
+    (void)destino;
+    (void)peso;
+    cerr << "Erro: GrafoTipado sem pesos nas arestas não armazena pesos."
+         << endl;
+  } else {
+    int i = (origem >= 1 && origem <= nNos ? saidas[origem - 1].busca(destino)
+                                           : -1);
+    if (i < 0) {
+      cerr << "Erro: Aresta de " << origem << " para " << destino
+           << " não existe." << endl;
+      return;
+    }
+    if (!Lista::cabe(peso)) {
+      cerr << "Erro: Peso " << peso << " fora do intervalo do tipo das "
+           << "arestas." << endl;
+      return;
+    }
+    int antigo = saidas[origem - 1].peso(i);
+    saidas[origem - 1].grava(i, peso);
+    // A cópia da aresta no destino: a reversa ou a entrada das origens
+    Lista &copia = (D ? entradas[destino - 1] : saidas[destino - 1]);
+    copia.grava(copia.busca(origem), peso);
+    registra_peso(origem, destino, antigo, peso);
+  }
+}
+
+template <bool D, typename P, bool PV>
+void GrafoTipado<D, P, PV>::deleta_aresta(int origem, int destino) {
+  INSTRUMENTA(OP_DELETA_ARESTA);
+  if (origem < 1 || origem > nNos) {
+    cerr << "Erro: Vértice " << origem << " não encontrado." << endl;
+    return;
+  }
+  registra_remocao();
+  int i = saidas[origem - 1].busca(destino);
+  if (i < 0)
+    return;
+  saidas[origem - 1].remove_em(i);
+  Lista &copia = (D ? entradas[destino - 1] : saidas[destino - 1]);
+  copia.remove_em(copia.busca(origem));
+}
+
+// novoId é calculado uma única vez; cada lista é filtrada no local,
+// preservando a ordem, e as listas dos nós restantes descem para as novas
+// posições sem cópia dos vetores
+template <bool D, typename P, bool PV>
+void GrafoTipado<D, P, PV>::remove_marcados(const bool *removido) {
+  registra_remocao();
+  int *novoId = new int[nNos];
+  int vivos = 0;
+  for (int v = 0; v < nNos; v++)
+    novoId[v] = (removido[v] ? 0 : ++vivos);
+
+  for (int v = 0; v < nNos; v++) {
+    if (removido[v]) {
+      saidas[v].libera();
+      if constexpr (D)
+        entradas[v].libera();
+      continue;
+    }
+    for (int lado = 0; lado < (D ? 2 : 1); lado++) {
+      Lista &l = (lado == 0 ? saidas[v] : entradas[v]);
+      int n = 0;
+      for (int i = 0; i < l.grau; i++) {
+        int w = novoId[l.destinos[i] - 1];
+        if (w == 0)
+          continue;
+        l.destinos[n] = w;
+        l.move(i, n);
+        n++;
+      }
+      l.grau = n;
+    }
+  }
+  for (int v = 0; v < nNos; v++) {
+    int nv = novoId[v] - 1;
+    if (nv < 0 || nv == v)
+      continue;
+    saidas[nv].assume(saidas[v]);
+    if constexpr (D)
+      entradas[nv].assume(entradas[v]);
+    this->grava_peso_vertice(nv, this->peso_vertice(v));
+  }
+  delete[] novoId;
+  nNos = ordem = vivos;
+}
+
+template <bool D, typename P, bool PV>
+void GrafoTipado<D, P, PV>::deleta_no(int id) {
+  INSTRUMENTA(OP_DELETA_NO);
+  if (id < 1 || id > nNos) {
+    cerr << "Erro: Vértice " << id << " não existe." << endl;
+    return;
+  }
+  bool *removido = new bool[nNos];
+  for (int v = 0; v < nNos; v++)
+    removido[v] = (v == id - 1);
+  remove_marcados(removido);
+  delete[] removido;
+}
+
+template <bool D, typename P, bool PV>
+void GrafoTipado<D, P, PV>::deleta_nos(const int *ids, int k) {
+  INSTRUMENTA(OP_DELETA_NOS);
+  bool *removido = new bool[nNos > 0 ? nNos : 1];
+  if (marca_remocoes(ids, k, nNos, removido) > 0)
+    remove_marcados(removido);
+  delete[] removido;
+}
+
+template <bool D, typename P, bool PV>
+void GrafoTipado<D, P, PV>::imprime_grafo() const {
+  std::cout << "Grafo (Tipado, " << (D ? "direcionado" : "não direcionado")
+            << "):" << std::endl;
+  std::cout << "Ordem: " << ordem << std::endl;
+  for (int v = 0; v < nNos; v++) {
+    std::cout << "Vértice " << (v + 1);
+    if (PV)
+      std::cout << " (peso: " << this->peso_vertice(v) << ")";
+    std::cout << " -> ";
+    const Lista &l = saidas[v];
+    if (l.grau == 0)
+      std::cout << "Sem vizinhos";
+    for (int i = l.grau - 1; i >= 0; i--)
+      std::cout << l.destinos[i] << " ";
+    std::cout << std::endl;
+  }
+}
@@ -0,0 +1,159 @@
+#ifndef GRAFOVERSIONADO_HPP
+#define GRAFOVERSIONADO_HPP
+
+#include "GerenciadorEpocas.hpp"
+#include "Grafo.hpp"
+#include <atomic>
+#include <cstdint>
+
+// Versão imutável do grafo (definida em GrafoVersionado.cpp)
+struct VersaoGrafo;
+
+// Consultas sobre uma versão: base da GrafoVersionado e dos instantâneos
+class VisaoVersao : public Grafo {
+protected:
+  const VersaoGrafo *versao;
+
+  VisaoVersao() : versao(nullptr) {}
+
+public:
+  // Número da versão vista (cresce a cada publicação)
+  long long get_numero_versao() const;
+
+  virtual void percorre_vizinhos(int vertice,
+                                 VisitanteVizinhos &visitante) const override;
+  virtual int get_grau_saida(int vertice) const override;
+  virtual int get_num_arestas() const override;
+  virtual int get_grau_entrada(int vertice) const override;
+  virtual void
+  percorre_predecessores(int vertice,
+                         VisitanteVizinhos &visitante) const override;
+  virtual int get_peso_vertice(int vertice) const override;
+  virtual double getPesoAresta(int origem, int destino) const override;
+  virtual void imprime_grafo() const override;
+};
+
+// Grafo com versões copy-on-write, para que várias threads façam consultas
+// (get_grau, n_conexo, calculaMaiorMenorDistancia...) enquanto outra o altera.
+//
+// Cada vértice ocupa uma posição fixa (não renumerada nas remoções) de uma
+// árvore de 32 ramos por nível, cujas folhas apontam para linhas de
+// adjacência imutáveis. Uma alteração copia apenas as linhas que muda e os
+// nós do caminho até elas (O(log n) nós), compartilhando o resto com a versão
+// anterior, e publica a nova versão de uma só vez. As arestas guardam
+// posições; os ids (renumerados como nas demais estruturas) são calculados
+// na leitura, por busca binária na lista ordenada das posições removidas,
+// também compartilhada entre as versões até a próxima remoção.
+//
+// As alterações devem vir de uma thread por vez; as consultas feitas pelo
+// próprio objeto também. Outras threads consultam por um InstantaneoGrafo,
+// que fixa a versão publicada no momento da criação e a lê sem travas,
+// enquanto o escritor continua publicando versões novas. As versões
+// substituídas são liberadas (com reclamação por épocas, GerenciadorEpocas)
+// nas publicações seguintes, depois que os instantâneos que as usam forem
+// destruídos; as partes compartilhadas com versões ainda vivas são mantidas
+// por contagem de referências.
+//
+// Durante a carga (entre reserva e fim_carga) as alterações vão para uma
+// única versão, publicada no final. Cada alteração depois dela, inclusive as
+// em lote (inserir_arestas_lote, deleta_nos, deleta_arestas), publica uma
+// versão. A ordem dos vizinhos é a da GrafoLista; arestas para vértices
+// inexistentes são recusadas.
+class GrafoVersionado : public VisaoVersao {
+  friend class InstantaneoGrafo;
+
+private:
+  // Versão lida pelos novos instantâneos
+  std::atomic<VersaoGrafo *> publicada;
+  // Versão em construção (nullptr fora das alterações e da carga)
+  VersaoGrafo *rascunho;
+  bool carregando;
+
+  // Versões substituídas, com a época da substituição, aguardando os leitores
+  VersaoGrafo **retiradas;
+  uint64_t *epocasRetirada;
+  int nRetiradas;
+  int capRetiradas;
+
+  // Abre o rascunho (se ainda não houver) a partir da versão publicada
+  VersaoGrafo *abre_rascunho();
+  // Publica o rascunho (ou o descarta, se nada mudou), exceto durante a
+  // carga
+  void conclui();
+  void publica();
+  void retira(VersaoGrafo *v, uint64_t epoca);
+  // Insere a aresta no rascunho; as recusas passam por reporta_recusa se
+  // 'carga' for true (inserir_aresta) e vão direto para cerr caso contrário
+  bool insere(int origem, int destino, int peso, bool carga);
+  bool remove_aresta(int origem, int destino);
+  // Remove o vértice da posição p e as arestas incidentes do rascunho
+  void remove_posicao(int p);
+
+  // Grafo cuja versão publicada compartilha a estrutura de 'base'
+  explicit GrafoVersionado(const VersaoGrafo *base);
+
+public:
+  GrafoVersionado();
+  // Cópia de outra estrutura (O(V+E)), que passa a servir de base para
+  // clona()
+  explicit GrafoVersionado(const Grafo &origem);
+  virtual ~GrafoVersionado();
+  GrafoVersionado(const GrafoVersionado &) = delete;
+  GrafoVersionado &operator=(const GrafoVersionado &) = delete;
+
+  // Libera as versões substituídas que nenhum instantâneo usa mais (também
+  // feito a cada publicação)
+  void recupera();
+  // Versões substituídas ainda não liberadas
+  int get_versoes_retidas() const { return nRetiradas; }
+  // Cópia da versão publicada em O(1) (durante a carga, da anterior a ela).
+  // Como as demais operações, deve ser chamada pela thread que altera o
+  // grafo; as outras clonam um InstantaneoGrafo. A cópia pode ser usada em
+  // outra thread e destruída antes ou depois do original.
+  GrafoVersionado *clona() const override;
+
+  virtual void inserir_vertice(int id, int peso = 0) override;
+  virtual void inserir_aresta(int origem, int destino, int peso = 0) override;
+  virtual void inserir_arestas_lote(const int *origens, const int *destinos,
+                                    const int *pesos, int n) override;
+  virtual void reserva(int nVertices, int nArestas) override;
+  virtual void fim_carga() override;
+
+  void novo_no(int peso = 0) override;
+  void nova_aresta(int origem, int destino, int peso) override;
+  void altera_peso_aresta(int origem, int destino, int peso) override;
+  void deleta_no(int id) override;
+  void deleta_aresta(int origem, int destino) override;
+  void deleta_nos(const int *ids, int k) override;
+  void deleta_arestas(const int *origens, const int *destinos,
+                      int n) override;
+};
+
+// Visão somente leitura da versão publicada de uma GrafoVersionado no
+// momento da criação. Não muda com as alterações seguintes do grafo e pode
+// ser usada em outra thread (um instantâneo por thread: os algoritmos da
+// classe base guardam estado no objeto). As alterações são recusadas. Deve
+// ser destruído antes do grafo, e cada instantâneo vivo retém a sua versão.
+class InstantaneoGrafo : public VisaoVersao {
+  int vaga;
+  void recusa() const;
+
+public:
+  explicit InstantaneoGrafo(const GrafoVersionado &grafo);
+  virtual ~InstantaneoGrafo();
+  InstantaneoGrafo(const InstantaneoGrafo &) = delete;
+  InstantaneoGrafo &operator=(const InstantaneoGrafo &) = delete;
+
+  // Grafo alterável que parte da versão do instantâneo, em O(1)
+  GrafoVersionado *clona() const override;
+
+  virtual void inserir_vertice(int id, int peso = 0) override;
+  virtual void inserir_aresta(int origem, int destino, int peso = 0) override;
+  void novo_no(int peso = 0) override;
+  void nova_aresta(int origem, int destino, int peso) override;
+  void altera_peso_aresta(int origem, int destino, int peso) override;
+  void deleta_no(int id) override;
+  void deleta_aresta(int origem, int destino) override;
+};
+
+#endif
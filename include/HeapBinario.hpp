@@ -0,0 +1,33 @@
+#ifndef HEAPBINARIO_HPP
+#define HEAPBINARIO_HPP
+
+// Heap binário de mínimo indexado pelos elementos 0..capacidade-1, com
+// diminuição de prioridade em O(log n). Usado pelo Dijkstra.
+class HeapBinario {
+private:
+  int *heap;          // elementos, organizados como heap
+  int *posicao;       // posição de cada elemento em 'heap' (-1 se ausente)
+  double *prioridade; // prioridade de cada elemento
+  int n;
+  int capacidade;
+  void sobe(int i);
+  void desce(int i);
+  void troca(int i, int j);
+
+public:
+  HeapBinario(int capacidade);
+  ~HeapBinario();
+  HeapBinario(const HeapBinario &) = delete;
+  HeapBinario &operator=(const HeapBinario &) = delete;
+
+  bool vazio() const { return n == 0; }
+  bool contem(int elemento) const { return posicao[elemento] >= 0; }
+  // Insere o elemento ou diminui a sua prioridade (se a nova for menor)
+  void insere_ou_diminui(int elemento, double novaPrioridade);
+  // Remove e retorna o elemento de menor prioridade
+  int remove_min();
+  // Esvazia o heap (custo proporcional ao número de elementos presentes)
+  void limpa();
+};
+
+#endif
@@ -0,0 +1,123 @@
+#ifndef INSTRUMENTACAO_HPP
+#define INSTRUMENTACAO_HPP
+
+#include <iosfwd>
+
+// Instrumentação das operações da biblioteca: número de chamadas, tempo
+// decorrido e bytes alocados por operação. Só é compilada com
+// -DGRAFOS_INSTRUMENTACAO (em todos os fontes); sem a macro os pontos de
+// medição não geram código e Grafo::estatisticas() devolve contadores
+// zerados.
+//
+// Os contadores são globais ao processo (somam todos os grafos e threads).
+// O tempo e os bytes de uma operação incluem os das operações chamadas por
+// ela (carrega_grafo inclui as inserções de arestas, por exemplo). Os bytes
+// são os alocados pelos pontos instrumentados (IntList, matrizes, nós das
+// listas, blocos das arenas e matriz do Floyd–Warshall) na mesma thread,
+// durante a operação. Operações curtas e muito frequentes (encontrar_vertice,
+// getPesoAresta, alocação de um nó de lista) só têm as chamadas contadas.
+enum OperacaoInstrumentada {
+  // Operações públicas de Grafo
+  OP_CARREGA_GRAFO,
+  OP_CARREGA_BINARIO,
+  OP_CARREGA_FLUXO,
+  OP_GET_GRAU,
+  OP_N_CONEXO,
+  OP_EH_COMPLETO,
+  OP_GET_VIZINHOS,
+  OP_GET_PESO_ARESTA,
+  OP_INSERIR_VERTICE,
+  OP_INSERIR_ARESTA,
+  OP_INSERIR_ARESTAS_LOTE,
+  OP_NOVO_NO,
+  OP_NOVA_ARESTA,
+  OP_ALTERA_PESO_ARESTA,
+  OP_DELETA_NO,
+  OP_DELETA_ARESTA,
+  OP_DELETA_NOS,
+  OP_DELETA_ARESTAS,
+  OP_COMPACTA,
+  OP_MAIOR_MENOR_DISTANCIA,
+  // Pontos internos
+  OP_ENCONTRAR_VERTICE,
+  OP_FLOYD_WARSHALL,
+  OP_INTLIST_RESIZE,
+  OP_REALOCAR_MATRIZ,
+  OP_NO_LISTA,
+  OP_BLOCO_ARENA,
+  OP_MIGRA_REPRESENTACAO,
+  OP_PUBLICA_VERSAO,
+  OP_CLONA,
+  N_OPERACOES_INSTRUMENTADAS
+};
+
+struct ContadorOperacao {
+  long long chamadas;
+  long long nanossegundos;
+  long long bytes;
+};
+
+// Cópia dos contadores em um instante
+struct EstatisticasGrafo {
+  bool ativa; // false se compilado sem GRAFOS_INSTRUMENTACAO
+  ContadorOperacao operacoes[N_OPERACOES_INSTRUMENTADAS];
+
+  static const char *nome(int operacao);
+  // false para as operações que só têm as chamadas contadas
+  static bool cronometrada(int operacao);
+  // {"instrumentacao": ..., "operacoes": {"nome": {"chamadas": ..., "ms":
+  // ..., "bytes": ...}, ...}}
+  void escreve_json(std::ostream &saida) const;
+};
+
+class Instrumentacao {
+public:
+  static EstatisticasGrafo leitura();
+  static void zera();
+
+  // Usadas pelas macros abaixo
+  static long long agora_ns();
+  static long long bytes_da_thread();
+  static void registra(int operacao, long long nanossegundos,
+                       long long bytes);
+  static void conta(int operacao);
+  static void conta_alocacao(int operacao, long long bytes);
+  static void registra_bytes(long long bytes);
+};
+
+// Mede a operação do início ao fim do escopo em que é declarado
+class MedidorOperacao {
+private:
+  int operacao;
+  long long inicio;
+  long long bytesInicio;
+
+public:
+  explicit MedidorOperacao(int operacao)
+      : operacao(operacao), inicio(Instrumentacao::agora_ns()),
+        bytesInicio(Instrumentacao::bytes_da_thread()) {}
+  ~MedidorOperacao() {
+    Instrumentacao::registra(operacao, Instrumentacao::agora_ns() - inicio,
+                             Instrumentacao::bytes_da_thread() - bytesInicio);
+  }
+  MedidorOperacao(const MedidorOperacao &) = delete;
+  MedidorOperacao &operator=(const MedidorOperacao &) = delete;
+};
+
+// INSTRUMENTA(op): chamadas, tempo e bytes até o fim do escopo
+// CONTA_CHAMADA(op): só a chamada
+// CONTA_ALOCACAO(op, bytes): uma chamada que aloca 'bytes'
+// REGISTRA_BYTES(bytes): bytes alocados dentro de uma operação medida
+#ifdef GRAFOS_INSTRUMENTACAO
+#define INSTRUMENTA(op) MedidorOperacao medidorOperacao(op)
+#define CONTA_CHAMADA(op) Instrumentacao::conta(op)
+#define CONTA_ALOCACAO(op, bytes) Instrumentacao::conta_alocacao(op, bytes)
+#define REGISTRA_BYTES(bytes) Instrumentacao::registra_bytes(bytes)
+#else
+#define INSTRUMENTA(op) ((void)0)
+#define CONTA_CHAMADA(op) ((void)0)
+#define CONTA_ALOCACAO(op, bytes) ((void)0)
+#define REGISTRA_BYTES(bytes) ((void)0)
+#endif
+
+#endif
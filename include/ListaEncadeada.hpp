@@ -1,6 +1,8 @@
 #ifndef LISTAENCADEADA_HPP
 #define LISTAENCADEADA_HPP
 
+#include "Instrumentacao.hpp"
+
 // Estrutura de nó genérica
 template <typename T> struct No {
   T dado;
@@ -8,19 +10,63 @@ template <typename T> struct No {
   No(const T &d) : dado(d), prox(0) {}
 };
 
+// Alocador de nós em blocos contíguos (slab): os nós de várias listas que
+// compartilham a mesma arena ficam próximos na memória, nós liberados são
+// reaproveitados por uma lista de livres e, ao destruir a arena, os blocos
+// inteiros são devolvidos de uma vez. Se descarta_tudo() for chamado antes
+// de destruir as listas, elas deixam de liberar os nós um a um.
+template <typename T> class ArenaNos {
+private:
+  struct NoLivre {
+    NoLivre *prox;
+  };
+  void **blocos;      // Blocos alocados
+  int nBlocos;
+  int capBlocos;
+  char *atual;        // Bloco em uso
+  long long usadosNoAtual; // Nós já entregues do bloco em uso
+  long long tamanhoAtual;  // Capacidade do bloco em uso, em nós
+  int nosPorBloco;         // Tamanho do último bloco criado por aloca()
+  NoLivre *livres;    // Nós liberados, reaproveitados por aloca()
+  bool descartando;
+  void novo_bloco(long long nNos);
+
+public:
+  explicit ArenaNos(int nosPorBlocoInicial = 64);
+  ~ArenaNos();
+  ArenaNos(const ArenaNos &) = delete;
+  ArenaNos &operator=(const ArenaNos &) = delete;
+
+  No<T> *aloca(const T &dado);
+  void libera(No<T> *no);
+  // Garante espaço para mais nNos nós sem novas alocações (um único bloco)
+  void reserva(long long nNos);
+  // Indica que todos os nós serão descartados junto com a arena
+  void descarta_tudo() { descartando = true; }
+  bool descartando_tudo() const { return descartando; }
+};
+
 template <typename T> class ListaEncadeada {
 private:
   No<T> *head;
+  No<T> *tail;
+  ArenaNos<T> *arena; // nullptr: nós alocados com new/delete
+  No<T> *cria_no(const T &dado);
+  void libera_no(No<T> *no);
 
 public:
-  ListaEncadeada();
+  explicit ListaEncadeada(ArenaNos<T> *arena = nullptr);
   ~ListaEncadeada();
+  ListaEncadeada(const ListaEncadeada &) = delete;
+  ListaEncadeada &operator=(const ListaEncadeada &) = delete;
   void inserir(const T &dado);
-  void append(const T &dado); // Insere no final
+  void append(const T &dado); // Insere no final, em O(1)
+  // Remove o nó seguinte a 'anterior' (o primeiro, se anterior for nullptr)
+  // e retorna o nó que ocupava a posição seguinte a ele
+  No<T> *remove_apos(No<T> *anterior);
 
   // Retorna o ponteiro para o primeiro nó (para iteração)
   No<T> *getHead() const;
-  void setHead(No<T> *novoHead) { head = novoHead; }
 };
 
 #include "ListaEncadeada.tpp"
@@ -1,33 +1,140 @@
-template <typename T> ListaEncadeada<T>::ListaEncadeada() : head(nullptr) {}
+#include <new>
+#include <type_traits>
+
+template <typename T>
+ArenaNos<T>::ArenaNos(int nosPorBlocoInicial)
+    : blocos(nullptr), nBlocos(0), capBlocos(0), atual(nullptr),
+      usadosNoAtual(0), tamanhoAtual(0), nosPorBloco(nosPorBlocoInicial / 2),
+      livres(nullptr), descartando(false) {
+  if (nosPorBloco < 1)
+    nosPorBloco = 1;
+}
+
+template <typename T> ArenaNos<T>::~ArenaNos() {
+  for (int i = 0; i < nBlocos; i++)
+    ::operator delete(blocos[i]);
+  delete[] blocos;
+}
+
+template <typename T> void ArenaNos<T>::novo_bloco(long long nNos) {
+  INSTRUMENTA(OP_BLOCO_ARENA);
+  REGISTRA_BYTES((long long)sizeof(No<T>) * nNos);
+  if (nBlocos == capBlocos) {
+    int novaCap = (capBlocos == 0 ? 8 : capBlocos * 2);
+    void **novos = new void *[novaCap];
+    for (int i = 0; i < nBlocos; i++)
+      novos[i] = blocos[i];
+    delete[] blocos;
+    blocos = novos;
+    capBlocos = novaCap;
+  }
+  atual = (char *)::operator new(sizeof(No<T>) * (size_t)nNos);
+  blocos[nBlocos++] = atual;
+  usadosNoAtual = 0;
+  tamanhoAtual = nNos;
+}
+
+template <typename T> void ArenaNos<T>::reserva(long long nNos) {
+  if (atual != nullptr && tamanhoAtual - usadosNoAtual >= nNos)
+    return;
+  if (nNos > 0)
+    novo_bloco(nNos);
+}
+
+template <typename T> No<T> *ArenaNos<T>::aloca(const T &dado) {
+  void *p;
+  if (livres != nullptr) {
+    NoLivre *livre = livres;
+    livres = livre->prox;
+    livre->~NoLivre();
+    p = livre;
+  } else {
+    if (atual == nullptr || usadosNoAtual == tamanhoAtual) {
+      // Blocos crescem geometricamente, até 64 Ki nós
+      if (nosPorBloco < 65536)
+        nosPorBloco *= 2;
+      novo_bloco(nosPorBloco);
+    }
+    p = atual + sizeof(No<T>) * (size_t)usadosNoAtual++;
+  }
+  return new (p) No<T>(dado);
+}
+
+template <typename T> void ArenaNos<T>::libera(No<T> *no) {
+  no->~No<T>();
+  // A memória do nó passa a guardar apenas o encadeamento da lista de livres
+  livres = new (static_cast<void *>(no)) NoLivre{livres};
+}
+
+template <typename T>
+ListaEncadeada<T>::ListaEncadeada(ArenaNos<T> *arena)
+    : head(nullptr), tail(nullptr), arena(arena) {}
 
 template <typename T> ListaEncadeada<T>::~ListaEncadeada() {
+  // Com a arena em descarte os blocos são liberados de uma vez; só é preciso
+  // percorrer os nós se o tipo tiver destrutor
+  if (arena != nullptr && arena->descartando_tudo() &&
+      std::is_trivially_destructible<T>::value)
+    return;
   No<T> *atual = head;
   while (atual) {
     No<T> *temp = atual;
     atual = atual->prox;
-    delete temp;
+    if (arena != nullptr && arena->descartando_tudo())
+      temp->~No<T>();
+    else
+      libera_no(temp);
   }
 }
 
+template <typename T> No<T> *ListaEncadeada<T>::cria_no(const T &dado) {
+  // Com arena, os bytes são contados nos blocos
+  CONTA_ALOCACAO(OP_NO_LISTA, arena != nullptr ? 0 : (long long)sizeof(No<T>));
+  if (arena != nullptr)
+    return arena->aloca(dado);
+  return new No<T>(dado);
+}
+
+template <typename T> void ListaEncadeada<T>::libera_no(No<T> *no) {
+  if (arena != nullptr)
+    arena->libera(no);
+  else
+    delete no;
+}
+
 template <typename T> void ListaEncadeada<T>::inserir(const T &dado) {
   // Método original: insere no início
-  No<T> *novo = new No<T>(dado);
+  No<T> *novo = cria_no(dado);
   novo->prox = head;
   head = novo;
+  if (tail == nullptr)
+    tail = novo;
 }
 
 template <typename T> void ListaEncadeada<T>::append(const T &dado) {
   // Método para inserir no final
-  No<T> *novo = new No<T>(dado);
+  No<T> *novo = cria_no(dado);
   if (head == nullptr) {
     head = novo;
   } else {
-    No<T> *atual = head;
-    while (atual->prox != nullptr) {
-      atual = atual->prox;
-    }
-    atual->prox = novo;
+    tail->prox = novo;
   }
+  tail = novo;
+}
+
+template <typename T> No<T> *ListaEncadeada<T>::remove_apos(No<T> *anterior) {
+  No<T> *alvo = (anterior == nullptr ? head : anterior->prox);
+  if (alvo == nullptr)
+    return nullptr;
+  No<T> *prox = alvo->prox;
+  if (anterior == nullptr)
+    head = prox;
+  else
+    anterior->prox = prox;
+  if (tail == alvo)
+    tail = anterior;
+  libera_no(alvo);
+  return prox;
 }
 
 template <typename T> No<T> *ListaEncadeada<T>::getHead() const { return head; }
@@ -0,0 +1,62 @@
+#ifndef POOLTHREADS_HPP
+#define POOLTHREADS_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// Conjunto fixo de threads que executa lotes de tarefas independentes
+// (índices 0..nTarefas-1). A thread que chama para_cada também executa
+// tarefas e só retorna quando todo o lote terminou.
+class PoolThreads {
+public:
+  // nThreads inclui a thread chamadora; 0 usa o número de núcleos da máquina
+  explicit PoolThreads(int nThreads = 0);
+  ~PoolThreads();
+  PoolThreads(const PoolThreads &) = delete;
+  PoolThreads &operator=(const PoolThreads &) = delete;
+
+  int tamanho() const { return nTrabalhadores + 1; }
+
+  // Executa funcao(i) para todo i em [0, nTarefas)
+  template <typename F> void para_cada(int nTarefas, F funcao);
+
+  // Pool compartilhado pelos algoritmos da biblioteca
+  static PoolThreads &global();
+
+private:
+  struct Tarefa {
+    virtual ~Tarefa() {}
+    virtual void executa(int i) = 0;
+  };
+  template <typename F> struct AdaptadorTarefa : public Tarefa {
+    F &f;
+    AdaptadorTarefa(F &f) : f(f) {}
+    void executa(int i) override { f(i); }
+  };
+
+  void executa_lote(int nTarefas, Tarefa &tarefa);
+  void consome(Tarefa &tarefa, int total);
+  void trabalha();
+
+  std::thread *trabalhadores;
+  int nTrabalhadores;
+  std::mutex mtxLote; // um lote por vez; chamadas concorrentes rodam inline
+  std::mutex mtx;
+  std::condition_variable cvInicio;
+  std::condition_variable cvFim;
+  Tarefa *atual;
+  int total;
+  std::atomic<int> proxima;
+  int ativos;
+  long long geracao;
+  bool encerrar;
+};
+
+template <typename F> void PoolThreads::para_cada(int nTarefas, F funcao) {
+  AdaptadorTarefa<F> tarefa(funcao);
+  executa_lote(nTarefas, tarefa);
+}
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef SERVIDORCONSULTAS_HPP
+#define SERVIDORCONSULTAS_HPP
+
+#include "Grafo.hpp"
+#include <string>
+using namespace std;
+
+// Modo servidor: mantém um grafo já carregado e responde a comandos, um por
+// linha, lidos de um descritor (entrada padrão) ou de conexões em um socket
+// Unix local. Cada comando recebe exatamente uma linha de resposta, na ordem
+// dos comandos, e as respostas de tudo o que já foi lido são enviadas de uma
+// vez antes da próxima leitura, de modo que o cliente pode enviar vários
+// comandos sem esperar as respostas (pipelining).
+//
+// Alterações (resposta "ok"; novo_no responde "ok <id>" com o id do nó):
+//   novo_no [peso]
+//   nova_aresta origem destino [peso]     (peso padrão 1)
+//   deleta_no id
+//   deleta_aresta origem destino
+//   altera_peso origem destino peso
+// Consultas:
+//   ordem, arestas                        número de vértices / de arestas
+//   grau [vertice]                        grau do grafo ou do vértice
+//   componentes                           número de componentes conexas
+//   completo                              "sim" ou "nao"
+//   diametro                              "no1 no2 distancia" ou
+//                                         "indefinida" (ciclo negativo)
+//   vizinhos vertice                      "k v1 ... vk"
+// Controle: sair (fecha a conexão), encerrar (também para o servidor do
+// socket). Linhas vazias ou iniciadas por '#' são ignoradas; comandos
+// inválidos ou com vértices inexistentes recebem "erro <motivo>".
+//
+// As alterações são enfileiradas e só aplicadas antes da próxima consulta,
+// antes de novo_no (cuja resposta depende da ordem atual) e antes de enviar
+// as respostas e esperar por mais dados. Cada sequência de alterações
+// consecutivas do mesmo tipo é aplicada com uma única chamada
+// (inserir_arestas_lote, deleta_arestas ou deleta_nos), com o mesmo
+// resultado das chamadas individuais. As recusas da biblioteca (aresta
+// repetida, vértice inexistente...) continuam sendo informadas na saída de
+// erro do servidor; "ok" indica que a alteração foi processada.
+class ServidorConsultas {
+public:
+  enum Fim {
+    FIM_ENTRADA, // a entrada terminou
+    FIM_SAIR,    // comando sair
+    FIM_ENCERRAR // comando encerrar
+  };
+
+  explicit ServidorConsultas(Grafo &grafo);
+  ~ServidorConsultas();
+  ServidorConsultas(const ServidorConsultas &) = delete;
+  ServidorConsultas &operator=(const ServidorConsultas &) = delete;
+
+  // Atende os comandos lidos de 'entrada' até o fim, sair ou encerrar,
+  // escrevendo as respostas em 'saida' (descritores de arquivo)
+  Fim atende(int entrada, int saida);
+  // Escuta no socket Unix 'caminho' e atende uma conexão por vez até o
+  // comando encerrar. Retorna false se o socket não puder ser criado (ou
+  // se o sistema não tiver sockets Unix).
+  bool escuta(const string &caminho);
+
+private:
+  enum TipoAlteracao { NOVA_ARESTA, DELETA_NO, DELETA_ARESTA, ALTERA_PESO };
+
+  Grafo &grafo;
+
+  // Alterações pendentes: tipo e até três argumentos de cada uma
+  int *tipos;
+  int *args[3];
+  int nPendentes;
+  int capPendentes;
+  // Ordem do grafo depois das alterações pendentes, usada para recusar
+  // comandos com vértices inexistentes antes de enfileirá-los
+  int ordemPrevista;
+
+  // Respostas ainda não enviadas
+  char *resposta;
+  size_t tamResposta;
+  size_t capResposta;
+
+  void enfileira(TipoAlteracao tipo, int a, int b, int c);
+  void aplica_pendentes();
+  // Executa uma linha (sem a quebra); retorna false em sair/encerrar
+  bool executa(char *linha, Fim &motivo);
+  void responde(const char *texto);
+  void responde_inteiro(long long valor);
+  // Aplica as alterações pendentes e escreve as respostas acumuladas
+  bool envia(int saida);
+};
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef UNIAOBUSCA_HPP
+#define UNIAOBUSCA_HPP
+
+// Estrutura de conjuntos disjuntos (union-find) com compressão de caminho e
+// união por rank. Os elementos são numerados de 0 a tamanho() - 1.
+class UniaoBusca {
+private:
+  int *pai;
+  int *rank;
+  int n;             // Número de elementos
+  int capacidade;    // Capacidade dos vetores
+  int nComponentes;  // Número de conjuntos distintos
+  void resize(int novaCapacidade);
+
+public:
+  UniaoBusca();
+  ~UniaoBusca();
+  UniaoBusca(const UniaoBusca &) = delete;
+  UniaoBusca &operator=(const UniaoBusca &) = delete;
+
+  // Descarta os conjuntos atuais e cria n elementos isolados
+  void reinicia(int n);
+  // Acrescenta um elemento isolado e retorna o seu índice
+  int adiciona();
+  // Retorna o representante do conjunto de x
+  int encontra(int x);
+  // Une os conjuntos de a e b; retorna false se já estavam unidos
+  bool une(int a, int b);
+  int tamanho() const { return n; }
+  int componentes() const { return nComponentes; }
+};
+
+#endif
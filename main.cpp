@@ -1,32 +1,193 @@
 
 #include "./include/Grafo.hpp"
+#include "./include/GrafoAdaptativo.hpp"
+#include "./include/GrafoBitMatriz.hpp"
+#include "./include/GrafoCSR.hpp"
 #include "./include/GrafoLista.hpp"
 #include "./include/GrafoMatriz.hpp"
+#include "./include/GrafoTipado.hpp"
+#include "./include/GrafoVersionado.hpp"
+#include "./include/ServidorConsultas.hpp"
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <string>
 using namespace std;
 
+// Destino do JSON de --stats (vazio: saída de erro), escrito ao sair
+static string arquivoEstatisticas;
+
+static void escreve_estatisticas() {
+  EstatisticasGrafo estatisticas = Grafo::estatisticas();
+  if (arquivoEstatisticas.empty()) {
+    estatisticas.escreve_json(cerr);
+    return;
+  }
+  ofstream saida(arquivoEstatisticas.c_str());
+  if (!saida)
+    cerr << "Erro ao criar " << arquivoEstatisticas << endl;
+  else
+    estatisticas.escreve_json(saida);
+}
+
 int main(int argc, char *argv[]) {
   if (argc < 4) {
-    cout << "Uso: " << argv[0] << " -d -m|-l grafo.txt" << endl;
+    cout << "Uso: " << argv[0]
+         << " -d -m|-l|-c|-b|-t|-a|-v grafo.txt "
+            "[--distancia=auto|escalar|blocado|johnson|bfs|aproximada] "
+            "[--varreduras=N] [--carga-paralela] [--relatorio-arestas=N] "
+            "[--relatorio-ms=T] [--ordem-maxima=N] [--stats[=arquivo.json]] "
+            "[--peso=auto|nenhum|int8|int16|int32|float] "
+            "[--servidor | --socket=caminho]"
+         << endl;
+    cout << "     (grafo.txt = - lê as arestas continuamente da entrada "
+            "padrão)"
+         << endl;
+    cout << "     " << argv[0] << " --converte grafo.txt grafo.bin" << endl;
     return 1;
   }
 
+  // Conversão do formato texto para o binário
+  if (string(argv[1]) == "--converte") {
+    GrafoCSR grafo;
+    grafo.carrega_grafo(argv[2]);
+    return (grafo.salva_binario(argv[3]) ? 0 : 1);
+  }
+
   string flagDirecao = argv[1];
-  string flagEstrutura = argv[2]; // -m ou -l
+  string flagEstrutura = argv[2]; // -m, -l, -c, -b, -t, -a ou -v
   string nomeArquivo = argv[3];
 
+  // Tipo do peso das arestas da GrafoTipado (-t), lido antes da criação do
+  // grafo, já que escolhe a instanciação
+  TipoPesoAresta tipoPeso = PESO_AUTOMATICO;
+  for (int i = 4; i < argc; i++) {
+    string opcao = argv[i];
+    if (opcao.compare(0, 7, "--peso=") == 0 &&
+        !tipo_peso_por_nome(opcao.substr(7), tipoPeso)) {
+      cout << "Tipo de peso inválido: " << opcao.substr(7) << endl;
+      return 1;
+    }
+  }
+
   Grafo *grafo = nullptr;
   if (flagEstrutura == "-m")
     grafo = new GrafoMatriz();
   else if (flagEstrutura == "-l")
     grafo = new GrafoLista();
+  else if (flagEstrutura == "-c")
+    grafo = new GrafoCSR();
+  else if (flagEstrutura == "-b")
+    grafo = new GrafoBitMatriz();
+  else if (flagEstrutura == "-t") {
+    // A instanciação depende do cabeçalho, que a entrada padrão só entrega
+    // durante a leitura
+    if (nomeArquivo == "-") {
+      cout << "A estrutura -t exige um arquivo (não lê da entrada padrão)."
+           << endl;
+      return 1;
+    }
+    grafo = cria_grafo_tipado(nomeArquivo, tipoPeso);
+    if (grafo == nullptr)
+      return 1;
+  } else if (flagEstrutura == "-a")
+    grafo = new GrafoAdaptativo();
+  else if (flagEstrutura == "-v")
+    grafo = new GrafoVersionado();
   else {
-    cout << "Estrutura inválida. Use -m para matriz ou -l para lista." << endl;
+    cout << "Estrutura inválida. Use -m para matriz, -l para lista, -c para "
+            "CSR, -b para matriz de bits, -t para a lista tipada, -a para a "
+            "escolha automática entre lista e matriz ou -v para o grafo "
+            "versionado."
+         << endl;
     return 1;
   }
 
-  grafo->carrega_grafo(nomeArquivo);
+  // Intervalos dos relatórios da carga contínua (0 desativa)
+  int relatorioArestas = 100000;
+  int relatorioMs = 1000;
+  bool estatisticas = false;
+  // Modo servidor: comandos da entrada padrão ou de um socket Unix
+  bool servidor = false;
+  string caminhoSocket;
+
+  // Opções adicionais
+  for (int i = 4; i < argc; i++) {
+    string opcao = argv[i];
+    if (opcao == "--distancia=auto")
+      grafo->set_modo_distancia(Grafo::DISTANCIA_AUTOMATICA);
+    else if (opcao == "--distancia=escalar")
+      grafo->set_modo_distancia(Grafo::DISTANCIA_FW_ESCALAR);
+    else if (opcao == "--distancia=blocado")
+      grafo->set_modo_distancia(Grafo::DISTANCIA_FW_BLOCADO);
+    else if (opcao == "--distancia=johnson")
+      grafo->set_modo_distancia(Grafo::DISTANCIA_JOHNSON);
+    else if (opcao == "--distancia=bfs")
+      grafo->set_modo_distancia(Grafo::DISTANCIA_BFS_EXATO);
+    else if (opcao == "--distancia=aproximada")
+      grafo->set_modo_distancia(Grafo::DISTANCIA_BFS_APROXIMADO);
+    else if (opcao.compare(0, 13, "--varreduras=") == 0)
+      grafo->set_varreduras_diametro(atoi(opcao.c_str() + 13));
+    else if (opcao == "--carga-paralela")
+      grafo->set_carga_paralela(true);
+    else if (opcao.compare(0, 20, "--relatorio-arestas=") == 0)
+      relatorioArestas = atoi(opcao.c_str() + 20);
+    else if (opcao.compare(0, 15, "--relatorio-ms=") == 0)
+      relatorioMs = atoi(opcao.c_str() + 15);
+    else if (opcao.compare(0, 15, "--ordem-maxima=") == 0)
+      grafo->set_ordem_maxima_fluxo(atoi(opcao.c_str() + 15));
+    else if (opcao == "--stats" || opcao.compare(0, 8, "--stats=") == 0) {
+      if (opcao.size() > 8)
+        arquivoEstatisticas = opcao.substr(8);
+      estatisticas = true;
+    } else if (opcao == "--servidor")
+      servidor = true;
+    else if (opcao.compare(0, 9, "--socket=") == 0 && opcao.size() > 9)
+      caminhoSocket = opcao.substr(9);
+    else if (opcao.compare(0, 7, "--peso=") == 0) {
+      // Já tratada acima (só tem efeito com -t)
+    } else {
+      cout << "Opção inválida: " << opcao << endl;
+      delete grafo;
+      return 1;
+    }
+  }
+
+  // No modo --servidor a entrada padrão traz os comandos
+  if (servidor && nomeArquivo == "-") {
+    cout << "--servidor lê os comandos da entrada padrão; use um arquivo "
+            "para o grafo ou --socket."
+         << endl;
+    delete grafo;
+    return 1;
+  }
+
+  if (estatisticas)
+    atexit(escreve_estatisticas);
+
+  // Arquivos gerados por --converte são reconhecidos pela assinatura
+  if (nomeArquivo == "-") {
+    if (!grafo->carrega_fluxo(stdin, cout, relatorioArestas, relatorioMs)) {
+      delete grafo;
+      return 1;
+    }
+  } else if (Grafo::eh_arquivo_binario(nomeArquivo))
+    grafo->carrega_binario(nomeArquivo);
+  else
+    grafo->carrega_grafo(nomeArquivo);
+
+  // Modo servidor: o grafo carregado atende os comandos até o fim
+  if (servidor || !caminhoSocket.empty()) {
+    cout.flush();
+    ServidorConsultas consultas(*grafo);
+    bool ok = true;
+    if (!caminhoSocket.empty())
+      ok = consultas.escuta(caminhoSocket);
+    else
+      consultas.atende(0, 1);
+    delete grafo;
+    return (ok ? 0 : 1);
+  }
 
   // cout << "Grafo carregado: Ordem = " << grafo->get_ordem() << endl;
 
@@ -59,8 +220,11 @@ int main(int argc, char *argv[]) {
 
   // Cálculo e impressão da maior menor distância (diâmetro do grafo)
   Grafo::ResultadoDistancia res = grafo->calculaMaiorMenorDistancia();
-  cout << "Maior menor distância: (" << res.no1 << "-" << res.no2 << ") "
-       << res.distancia << endl;
+  if (res.cicloNegativo)
+    cout << "Maior menor distância: indefinida (ciclo negativo)" << endl;
+  else
+    cout << "Maior menor distância: (" << res.no1 << "-" << res.no2 << ") "
+         << res.distancia << endl;
 
   delete grafo;
   return 0;
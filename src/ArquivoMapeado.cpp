@@ -0,0 +1,68 @@
+#include "../include/ArquivoMapeado.hpp"
+#include <cstdio>
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+bool ArquivoMapeado::abre(const string &nomeArquivo) {
+  fecha();
+#if !defined(_WIN32)
+  int fd = open(nomeArquivo.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    close(fd);
+    return false;
+  }
+  nBytes = (size_t)info.st_size;
+  if (nBytes > 0) {
+    void *p = mmap(nullptr, nBytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p != MAP_FAILED) {
+      // A leitura é sequencial: o núcleo pode ler adiante
+      madvise(p, nBytes, MADV_SEQUENTIAL);
+      dados = (char *)p;
+      mapeado = true;
+      close(fd);
+      return true;
+    }
+  }
+  close(fd);
+  if (nBytes == 0)
+    return true;
+  // mmap falhou (ex.: pipe ou sistema de arquivos sem suporte): lê com fread
+#endif
+  FILE *arquivo = fopen(nomeArquivo.c_str(), "rb");
+  if (arquivo == nullptr)
+    return false;
+  fseek(arquivo, 0, SEEK_END);
+  long tam = ftell(arquivo);
+  fseek(arquivo, 0, SEEK_SET);
+  if (tam < 0) {
+    fclose(arquivo);
+    return false;
+  }
+  nBytes = (size_t)tam;
+  dados = new char[nBytes + 1];
+  size_t lidos = fread(dados, 1, nBytes, arquivo);
+  fclose(arquivo);
+  nBytes = lidos;
+  mapeado = false;
+  return true;
+}
+
+void ArquivoMapeado::fecha() {
+#if !defined(_WIN32)
+  if (mapeado && dados != nullptr)
+    munmap(dados, nBytes);
+  else
+#endif
+    delete[] dados;
+  dados = nullptr;
+  nBytes = 0;
+  mapeado = false;
+}
@@ -0,0 +1,80 @@
+#include "../include/ArvoreFenwick.hpp"
+
+ArvoreFenwick::ArvoreFenwick()
+    : arvore(nullptr), vivo(nullptr), n(0), capacidade(0) {}
+
+ArvoreFenwick::~ArvoreFenwick() {
+  delete[] arvore;
+  delete[] vivo;
+}
+
+void ArvoreFenwick::resize(int novaCapacidade) {
+  int *novaArvore = new int[novaCapacidade + 1];
+  bool *novoVivo = new bool[novaCapacidade + 1];
+  for (int i = 1; i <= n; i++) {
+    novaArvore[i] = arvore[i];
+    novoVivo[i] = vivo[i];
+  }
+  delete[] arvore;
+  delete[] vivo;
+  arvore = novaArvore;
+  vivo = novoVivo;
+  capacidade = novaCapacidade;
+}
+
+void ArvoreFenwick::reinicia(int total) {
+  if (total > capacidade || vivo == nullptr)
+    resize(total);
+  n = total;
+  // A posição 0 não existe; fica definida (e removida) para esta_viva(0)
+  arvore[0] = 0;
+  vivo[0] = false;
+  // Com todas as posições valendo 1, cada nó soma exatamente lowbit(i)
+  for (int i = 1; i <= n; i++) {
+    arvore[i] = i & -i;
+    vivo[i] = true;
+  }
+}
+
+int ArvoreFenwick::adiciona() {
+  if (n == capacidade)
+    resize(capacidade == 0 ? 10 : capacidade * 2);
+  n++;
+  // O novo nó cobre (n - lowbit(n), n]: as posições anteriores desse
+  // intervalo mais a própria posição
+  arvore[n] = prefixo(n - 1) - prefixo(n - (n & -n)) + 1;
+  vivo[n] = true;
+  return n;
+}
+
+void ArvoreFenwick::remove(int posicao) {
+  if (posicao < 1 || posicao > n || !vivo[posicao])
+    return;
+  vivo[posicao] = false;
+  for (int i = posicao; i <= n; i += i & -i)
+    arvore[i]--;
+}
+
+int ArvoreFenwick::prefixo(int posicao) const {
+  int soma = 0;
+  for (int i = posicao; i > 0; i -= i & -i)
+    soma += arvore[i];
+  return soma;
+}
+
+int ArvoreFenwick::seleciona(int k) const {
+  if (k < 1)
+    return -1;
+  int passo = 1;
+  while (passo * 2 <= n)
+    passo *= 2;
+  // Desce pela árvore acumulando os intervalos com soma menor que k
+  int pos = 0;
+  for (; passo > 0; passo /= 2) {
+    if (pos + passo <= n && arvore[pos + passo] < k) {
+      pos += passo;
+      k -= arvore[pos];
+    }
+  }
+  return (pos + 1 <= n ? pos + 1 : -1);
+}
@@ -0,0 +1,632 @@
+#include "../include/ArquivoMapeado.hpp"
+#include "../include/Grafo.hpp"
+#include "../include/PoolThreads.hpp"
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <poll.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+// Leitura do formato texto:
+//   ordem direcionado ponderadoVertices ponderadoArestas
+//   [peso de cada vértice, se ponderadoVertices]
+//   origem destino [peso]      (uma aresta por linha)
+// O cabeçalho e os pesos dos vértices podem estar distribuídos em qualquer
+// número de linhas; as arestas são lidas linha a linha.
+
+// Cursor sobre o conteúdo do arquivo
+struct AnalisadorTexto {
+  const char *p;
+  const char *fim;
+  int linha; // linha atual (1-based)
+
+  AnalisadorTexto(const char *inicio, const char *fim)
+      : p(inicio), fim(fim), linha(1) {}
+
+  static bool eh_espaco(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+  }
+
+  // Lê um inteiro decimal (com sinal opcional). Sem 'mesmaLinha', quebras de
+  // linha também são puladas. Retorna 1 se leu, 0 no fim da linha ou do
+  // arquivo e -1 se encontrou algo que não é um inteiro (o cursor fica no
+  // caractere inválido).
+  int le_inteiro(int &valor, bool mesmaLinha) {
+    for (;;) {
+      while (p < fim && eh_espaco(*p))
+        p++;
+      if (p == fim || *p != '\n')
+        break;
+      if (mesmaLinha)
+        return 0;
+      linha++;
+      p++;
+    }
+    if (p == fim)
+      return 0;
+    bool negativo = (*p == '-');
+    const char *q = p + (negativo || *p == '+');
+    const char *inicioDigitos = q;
+    long long v = 0;
+    // Mais de 10 dígitos sempre excede o intervalo de int
+    while (q < fim && q - inicioDigitos <= 10) {
+      unsigned d = (unsigned)(*q - '0');
+      if (d > 9)
+        break;
+      v = v * 10 + d;
+      q++;
+    }
+    if (q == inicioDigitos || (q < fim && !eh_espaco(*q) && *q != '\n'))
+      return -1;
+    if (negativo)
+      v = -v;
+    if (v > 2147483647LL || v < -2147483648LL)
+      return -1;
+    valor = (int)v;
+    p = q;
+    return 1;
+  }
+
+  // Avança até o início da próxima linha
+  void proxima_linha() {
+    const char *q = (const char *)memchr(p, '\n', fim - p);
+    p = (q == nullptr ? fim : q + 1);
+    linha++;
+  }
+
+  // Lê uma linha de aresta e avança para a linha seguinte. Retorna 1 se a
+  // linha tem exatamente 'esperados' inteiros (copiados para valores), 0 se
+  // está vazia e -1 se é malformada.
+  int le_aresta(int esperados, int *valores) {
+    int lidos = 0;
+    int valor;
+    int r;
+    while ((r = le_inteiro(valor, true)) == 1) {
+      if (lidos < 3)
+        valores[lidos] = valor;
+      lidos++;
+    }
+    if (p < fim)
+      proxima_linha();
+    if (r == 0 && lidos == 0)
+      return 0;
+    return (r < 0 || lidos != esperados ? -1 : 1);
+  }
+
+  // Limite superior para o número de linhas restantes
+  int conta_linhas() const {
+    long long total = 1;
+    for (const char *q = p; q < fim; q++) {
+      q = (const char *)memchr(q, '\n', fim - q);
+      if (q == nullptr)
+        break;
+      total++;
+    }
+    return (total > 2147483647LL ? 2147483647 : (int)total);
+  }
+};
+
+// Arestas lidas de um trecho da seção de arestas (carga paralela)
+struct TrechoArestas {
+  const char *inicio;
+  const char *fim;
+  int *origens;
+  int *destinos;
+  int *pesos;
+  int n;
+  int capacidade;
+  int linhas;             // linhas do trecho
+  int malformadas;
+  int primeiraMalformada; // relativa ao início do trecho (1-based)
+
+  TrechoArestas()
+      : inicio(nullptr), fim(nullptr), origens(nullptr), destinos(nullptr),
+        pesos(nullptr), n(0), capacidade(0), linhas(0), malformadas(0),
+        primeiraMalformada(0) {}
+  ~TrechoArestas() {
+    delete[] origens;
+    delete[] destinos;
+    delete[] pesos;
+  }
+  TrechoArestas(const TrechoArestas &) = delete;
+  TrechoArestas &operator=(const TrechoArestas &) = delete;
+
+  void adiciona(int origem, int destino, int peso) {
+    if (n == capacidade) {
+      int novaCap = (capacidade == 0 ? 1024 : capacidade * 2);
+      int *no = new int[novaCap];
+      int *nd = new int[novaCap];
+      int *np = new int[novaCap];
+      for (int i = 0; i < n; i++) {
+        no[i] = origens[i];
+        nd[i] = destinos[i];
+        np[i] = pesos[i];
+      }
+      delete[] origens;
+      delete[] destinos;
+      delete[] pesos;
+      origens = no;
+      destinos = nd;
+      pesos = np;
+      capacidade = novaCap;
+    }
+    origens[n] = origem;
+    destinos[n] = destino;
+    pesos[n] = peso;
+    n++;
+  }
+
+  void le(int esperados, bool ponderado) {
+    AnalisadorTexto leitor(inicio, fim);
+    int valores[3];
+    while (leitor.p < leitor.fim) {
+      int linha = leitor.linha;
+      int r = leitor.le_aresta(esperados, valores);
+      if (r < 0 && malformadas++ == 0)
+        primeiraMalformada = linha;
+      if (r > 0)
+        adiciona(valores[0], valores[1], ponderado ? valores[2] : 1);
+    }
+    linhas = leitor.linha - 1;
+  }
+};
+
+// Trechos de no mínimo este tamanho (menos trechos em arquivos pequenos)
+const size_t BYTES_MINIMOS_POR_TRECHO = 1 << 16;
+
+void Grafo::inserir_arestas_lote(const int *origens, const int *destinos,
+                                 const int *pesos, int n) {
+  INSTRUMENTA(OP_INSERIR_ARESTAS_LOTE);
+  for (int i = 0; i < n; i++)
+    inserir_aresta(origens[i], destinos[i], pesos[i]);
+}
+
+void Grafo::carrega_grafo(const string &nomeArquivo) {
+  INSTRUMENTA(OP_CARREGA_GRAFO);
+  ArquivoMapeado arquivo;
+  if (!arquivo.abre(nomeArquivo)) {
+    cerr << "Erro ao abrir o arquivo " << nomeArquivo << "\n";
+    return;
+  }
+  AnalisadorTexto leitor(arquivo.inicio(), arquivo.fim());
+
+  int cabecalho[4];
+  for (int i = 0; i < 4; i++) {
+    if (leitor.le_inteiro(cabecalho[i], false) != 1 || cabecalho[i] < 0) {
+      cerr << "Erro: cabeçalho inválido em " << nomeArquivo << " (linha "
+           << leitor.linha << ").\n";
+      return;
+    }
+  }
+  int n = cabecalho[0];
+  int *pesos = new int[n > 0 ? n : 1];
+  for (int i = 0; i < n; i++) {
+    pesos[i] = 0;
+    if (cabecalho[2] != 0 && leitor.le_inteiro(pesos[i], false) != 1) {
+      cerr << "Erro: peso do vértice " << (i + 1) << " inválido em "
+           << nomeArquivo << " (linha " << leitor.linha << ").\n";
+      delete[] pesos;
+      return;
+    }
+  }
+  ordem = n;
+  direcionado = (cabecalho[1] != 0);
+  ponderadoVertices = (cabecalho[2] != 0);
+  ponderadoArestas = (cabecalho[3] != 0);
+  // O restante da linha do cabeçalho (ou dos pesos) não contém arestas
+  int ignorado;
+  int r = leitor.le_inteiro(ignorado, true);
+  int malformadas = 0;
+  int primeiraMalformada = 0;
+  if (r != 0) {
+    malformadas++;
+    primeiraMalformada = leitor.linha;
+  }
+  if (leitor.p < leitor.fim)
+    leitor.proxima_linha();
+
+  reserva(n, leitor.conta_linhas());
+  for (int i = 1; i <= n; i++)
+    inserir_vertice(i, pesos[i - 1]);
+  delete[] pesos;
+
+  // Arestas: uma por linha, com 2 valores (3 se ponderadas); linhas vazias
+  // são ignoradas e as demais contadas como malformadas. Para grafos não
+  // ponderados, usar 1 para indicar a presença da aresta.
+  agrupaRecusas = true;
+  arestasRecusadas = 0;
+  const int esperados = (ponderadoArestas ? 3 : 2);
+  PoolThreads &pool = PoolThreads::global();
+  size_t restante = (size_t)(leitor.fim - leitor.p);
+  int nTrechos = pool.tamanho() * 4;
+  if ((size_t)nTrechos > restante / BYTES_MINIMOS_POR_TRECHO)
+    nTrechos = (int)(restante / BYTES_MINIMOS_POR_TRECHO);
+  if (!cargaParalela || nTrechos < 2) {
+    int valores[3];
+    while (leitor.p < leitor.fim) {
+      int linha = leitor.linha;
+      r = leitor.le_aresta(esperados, valores);
+      if (r < 0 && malformadas++ == 0)
+        primeiraMalformada = linha;
+      if (r > 0)
+        inserir_aresta(valores[0], valores[1],
+                       ponderadoArestas ? valores[2] : 1);
+    }
+  } else {
+    // Cada trecho termina logo após uma quebra de linha
+    TrechoArestas *trechos = new TrechoArestas[nTrechos];
+    const char *inicio = leitor.p;
+    for (int t = 0; t < nTrechos; t++) {
+      const char *fim = leitor.fim;
+      if (t + 1 < nTrechos) {
+        const char *alvo = leitor.p + restante / nTrechos * (t + 1);
+        if (alvo < inicio)
+          alvo = inicio;
+        const char *q = (const char *)memchr(alvo, '\n', leitor.fim - alvo);
+        fim = (q == nullptr ? leitor.fim : q + 1);
+      }
+      trechos[t].inicio = inicio;
+      trechos[t].fim = fim;
+      inicio = fim;
+    }
+    pool.para_cada(nTrechos, [&](int t) {
+      trechos[t].le(esperados, ponderadoArestas);
+    });
+
+    // Junta os trechos na ordem do arquivo
+    int total = 0;
+    int linhaTrecho = leitor.linha;
+    for (int t = 0; t < nTrechos; t++) {
+      if (trechos[t].malformadas > 0 && malformadas == 0)
+        primeiraMalformada = linhaTrecho + trechos[t].primeiraMalformada - 1;
+      malformadas += trechos[t].malformadas;
+      linhaTrecho += trechos[t].linhas;
+      total += trechos[t].n;
+    }
+    int *origens = new int[total > 0 ? total : 1];
+    int *destinos = new int[total > 0 ? total : 1];
+    int *pesosArestas = new int[total > 0 ? total : 1];
+    int *deslocamento = new int[nTrechos];
+    for (int t = 0, d = 0; t < nTrechos; d += trechos[t].n, t++)
+      deslocamento[t] = d;
+    pool.para_cada(nTrechos, [&](int t) {
+      TrechoArestas &trecho = trechos[t];
+      if (trecho.n == 0)
+        return;
+      memcpy(origens + deslocamento[t], trecho.origens, trecho.n * sizeof(int));
+      memcpy(destinos + deslocamento[t], trecho.destinos,
+             trecho.n * sizeof(int));
+      memcpy(pesosArestas + deslocamento[t], trecho.pesos,
+             trecho.n * sizeof(int));
+    });
+    delete[] trechos;
+    delete[] deslocamento;
+    inserir_arestas_lote(origens, destinos, pesosArestas, total);
+    delete[] origens;
+    delete[] destinos;
+    delete[] pesosArestas;
+  }
+  fim_carga();
+  agrupaRecusas = false;
+
+  if (malformadas > 0)
+    cerr << "Aviso: " << malformadas
+         << " linha(s) malformada(s) ignorada(s) em " << nomeArquivo
+         << " (primeira: linha " << primeiraMalformada << ").\n";
+  if (arestasRecusadas > 0)
+    cerr << "Aviso: " << arestasRecusadas
+         << " aresta(s) recusada(s) durante a carga (laços, repetidas ou com "
+            "vértices inexistentes).\n";
+  arestasRecusadas = 0;
+}
+
+// Espera até 'ms' milissegundos (-1: sem limite) por dados em 'entrada';
+// retorna false se o prazo terminou sem dados. No Windows a leitura apenas
+// bloqueia, e os relatórios por tempo só saem quando chegam dados.
+static bool espera_dados(FILE *entrada, long long ms) {
+#if defined(_WIN32)
+  (void)entrada;
+  (void)ms;
+  return true;
+#else
+  struct pollfd p;
+  p.fd = fileno(entrada);
+  p.events = POLLIN;
+  p.revents = 0;
+  int r;
+  do
+    r = poll(&p, 1, (int)ms);
+  while (r < 0 && errno == EINTR);
+  return r != 0; // com erro, a leitura seguinte o informa
+#endif
+}
+
+// Lê o que estiver disponível (até 'maximo' bytes), sem esperar encher o
+// buffer. Retorna 0 no fim da entrada e -1 em caso de erro.
+static long le_disponivel(FILE *entrada, char *destino, int maximo) {
+#if defined(_WIN32)
+  return _read(_fileno(entrada), destino, maximo);
+#else
+  ssize_t n;
+  do
+    n = read(fileno(entrada), destino, maximo);
+  while (n < 0 && errno == EINTR);
+  return (long)n;
+#endif
+}
+
+// Métricas da carga contínua, atualizadas a cada aresta aceita
+struct MetricasFluxo {
+  int *graus; // graus[v]: grau de saída (+ entrada, se direcionado) de v
+  int capacidade;
+  int grauMaximo;
+  long long lidas; // linhas de aresta não vazias
+  long long aceitas;
+  long long malformadas;
+  int primeiraMalformada;
+
+  MetricasFluxo()
+      : graus(nullptr), capacidade(0), grauMaximo(0), lidas(0), aceitas(0),
+        malformadas(0), primeiraMalformada(0) {}
+  ~MetricasFluxo() { delete[] graus; }
+  MetricasFluxo(const MetricasFluxo &) = delete;
+  MetricasFluxo &operator=(const MetricasFluxo &) = delete;
+
+  void malformada(int linha) {
+    if (malformadas++ == 0)
+      primeiraMalformada = linha;
+  }
+
+  // Uma aresta aceita soma 1 ao grau de cada extremo, tanto em grafos não
+  // direcionados (grau de saída) quanto em direcionados (saída + entrada)
+  void registra(int origem, int destino) {
+    int maior = (origem > destino ? origem : destino);
+    if (maior >= capacidade) {
+      int novaCap = (capacidade == 0 ? 1024 : capacidade);
+      while (novaCap <= maior)
+        novaCap = (novaCap > 1073741823 ? 2147483647 : novaCap * 2);
+      int *novos = new int[novaCap];
+      for (int v = 0; v < capacidade; v++)
+        novos[v] = graus[v];
+      for (int v = capacidade; v < novaCap; v++)
+        novos[v] = 0;
+      delete[] graus;
+      graus = novos;
+      capacidade = novaCap;
+    }
+    aceitas++;
+    if (++graus[origem] > grauMaximo)
+      grauMaximo = graus[origem];
+    if (++graus[destino] > grauMaximo)
+      grauMaximo = graus[destino];
+  }
+};
+
+bool Grafo::carrega_fluxo(FILE *entrada, ostream &relatorio, int aCadaArestas,
+                          int aCadaMs) {
+  INSTRUMENTA(OP_CARREGA_FLUXO);
+  const int TAMANHO_BUFFER = 1 << 16;
+  char *buffer = new char[TAMANHO_BUFFER];
+  int usados = 0;           // bytes no buffer (a última linha pode estar
+                            // incompleta)
+  bool descartando = false; // no meio de uma linha maior que o buffer
+  int linha = 1;            // linha do início do buffer
+
+  // Cabeçalho: 4 inteiros e, se os vértices forem ponderados, 1 peso por
+  // vértice. Os vértices são inseridos à medida que os pesos chegam.
+  int cabecalho[4];
+  int lidosCabecalho = 0;
+  int verticesInseridos = 0;
+  bool lendoArestas = false;
+  bool ok = true;
+  MetricasFluxo metricas;
+  int esperados = 2; // valores por linha de aresta
+
+  chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+  auto decorrido = [&]() -> long long {
+    return chrono::duration_cast<chrono::milliseconds>(
+               chrono::steady_clock::now() - inicio)
+        .count();
+  };
+  long long proximoMs = aCadaMs;
+  long long proximasArestas = aCadaArestas;
+  auto escreve_relatorio = [&](bool fim) {
+    relatorio << "[" << (fim ? "fim, " : "") << decorrido()
+              << " ms] arestas: " << metricas.lidas
+              << " (aceitas: " << metricas.aceitas
+              << ", recusadas: " << arestasRecusadas
+              << ", malformadas: " << metricas.malformadas
+              << ") | vértices: " << ordem
+              << " | grau máximo: " << metricas.grauMaximo
+              << " | componentes: " << n_conexo() << "\n";
+    relatorio.flush();
+  };
+
+  agrupaRecusas = true;
+  arestasRecusadas = 0;
+
+  // Processa as linhas completas em [ini, fim). Retorna false se o
+  // cabeçalho for inválido.
+  auto processa = [&](const char *ini, const char *fim) -> bool {
+    AnalisadorTexto leitor(ini, fim);
+    leitor.linha = linha;
+    while (!lendoArestas) {
+      int valor;
+      int r = leitor.le_inteiro(valor, false);
+      if (r == 0)
+        break; // o restante do cabeçalho ainda não chegou
+      if (r < 0 || (lidosCabecalho < 4 && valor < 0)) {
+        cerr << "Erro: cabeçalho inválido na entrada (linha " << leitor.linha
+             << ").\n";
+        return false;
+      }
+      if (lidosCabecalho == 0 && valor > ordemMaximaFluxo) {
+        cerr << "Erro: ordem do cabeçalho (" << valor
+             << ") acima da máxima (" << ordemMaximaFluxo << ").\n";
+        return false;
+      }
+      if (lidosCabecalho < 4) {
+        cabecalho[lidosCabecalho++] = valor;
+        if (lidosCabecalho == 4) {
+          ordem = cabecalho[0];
+          direcionado = (cabecalho[1] != 0);
+          ponderadoVertices = (cabecalho[2] != 0);
+          ponderadoArestas = (cabecalho[3] != 0);
+          esperados = (ponderadoArestas ? 3 : 2);
+          reserva(ordem, 0);
+          if (!ponderadoVertices) {
+            for (int i = 1; i <= ordem; i++)
+              inserir_vertice(i, 0);
+            verticesInseridos = ordem;
+          }
+        }
+      } else {
+        verticesInseridos++;
+        inserir_vertice(verticesInseridos, valor);
+      }
+      if (lidosCabecalho == 4 && verticesInseridos == ordem) {
+        // O restante da linha do cabeçalho (ou dos pesos) não contém arestas
+        int ignorado;
+        if (leitor.le_inteiro(ignorado, true) != 0)
+          metricas.malformada(leitor.linha);
+        if (leitor.p < leitor.fim)
+          leitor.proxima_linha();
+        lendoArestas = true;
+      }
+    }
+    int valores[3];
+    // Ids fora de 1..ordemMaximaFluxo tornam a linha malformada
+    auto id_valido = [this](int id) {
+      return id >= 1 && id <= ordemMaximaFluxo;
+    };
+    while (lendoArestas && leitor.p < leitor.fim) {
+      int linhaAresta = leitor.linha;
+      int r = leitor.le_aresta(esperados, valores);
+      if (r == 0)
+        continue;
+      metricas.lidas++;
+      if (r < 0 || !id_valido(valores[0]) || !id_valido(valores[1])) {
+        metricas.malformada(linhaAresta);
+      } else {
+        int o = valores[0];
+        int d = valores[1];
+        // Ids acima da ordem atual criam os nós que faltam
+        if (o != d) {
+          int maior = (o > d ? o : d);
+          while (ordem < maior)
+            novo_no();
+        }
+        int recusadasAntes = arestasRecusadas;
+        inserir_aresta(o, d, ponderadoArestas ? valores[2] : 1);
+        if (arestasRecusadas == recusadasAntes && o <= ordem && d <= ordem)
+          metricas.registra(o, d);
+      }
+      if (aCadaArestas > 0 && metricas.lidas >= proximasArestas) {
+        escreve_relatorio(false);
+        proximasArestas += aCadaArestas;
+      }
+    }
+    linha = leitor.linha;
+    return true;
+  };
+
+  bool fimEntrada = false;
+  while (ok && !fimEntrada) {
+    long long espera = -1;
+    if (aCadaMs > 0) {
+      espera = proximoMs - decorrido();
+      if (espera < 0)
+        espera = 0;
+    }
+    if (espera_dados(entrada, espera)) {
+      long n = le_disponivel(entrada, buffer + usados, TAMANHO_BUFFER - usados);
+      if (n < 0) {
+        cerr << "Erro ao ler a entrada: " << strerror(errno) << "\n";
+        ok = false;
+        break;
+      }
+      if (n == 0)
+        fimEntrada = true;
+      usados += (int)n;
+
+      if (descartando) {
+        const char *q = (const char *)memchr(buffer, '\n', usados);
+        if (q == nullptr) {
+          usados = 0;
+          continue;
+        }
+        int resto = usados - (int)(q + 1 - buffer);
+        memmove(buffer, q + 1, resto);
+        usados = resto;
+        descartando = false;
+        linha++;
+      }
+      // Apenas as linhas completas são processadas; no fim da entrada a
+      // última linha vale mesmo sem quebra de linha
+      int completos = usados;
+      if (!fimEntrada) {
+        while (completos > 0 && buffer[completos - 1] != '\n')
+          completos--;
+      }
+      if (completos == 0 && usados == TAMANHO_BUFFER) {
+        // Uma linha maior que o buffer nunca é válida: é descartada
+        if (!lendoArestas) {
+          cerr << "Erro: cabeçalho inválido na entrada (linha " << linha
+               << ").\n";
+          ok = false;
+          break;
+        }
+        metricas.lidas++;
+        metricas.malformada(linha);
+        descartando = true;
+        usados = 0;
+        continue;
+      }
+      if (!processa(buffer, buffer + completos)) {
+        ok = false;
+        break;
+      }
+      memmove(buffer, buffer + completos, usados - completos);
+      usados -= completos;
+    }
+    if (aCadaMs > 0 && decorrido() >= proximoMs) {
+      escreve_relatorio(false);
+      proximoMs = decorrido() + aCadaMs;
+    }
+  }
+  if (ok && !lendoArestas) {
+    cerr << "Erro: cabeçalho incompleto na entrada (linha " << linha << ").\n";
+    ok = false;
+  }
+  delete[] buffer;
+
+  if (ok) {
+    // Na GrafoCSR as repetidas só são descartadas aqui; nesse caso o grau
+    // máximo é recalculado uma vez
+    int recusadasAntes = arestasRecusadas;
+    fim_carga();
+    if (arestasRecusadas != recusadasAntes) {
+      metricas.aceitas -= arestasRecusadas - recusadasAntes;
+      metricas.grauMaximo = get_grau();
+    }
+    escreve_relatorio(true);
+  }
+  agrupaRecusas = false;
+
+  if (metricas.malformadas > 0)
+    cerr << "Aviso: " << metricas.malformadas
+         << " linha(s) malformada(s) ignorada(s) na entrada (primeira: linha "
+         << metricas.primeiraMalformada << ").\n";
+  if (arestasRecusadas > 0)
+    cerr << "Aviso: " << arestasRecusadas
+         << " aresta(s) recusada(s) durante a carga (laços, repetidas ou com "
+            "vértices inexistentes).\n";
+  arestasRecusadas = 0;
+  return ok;
+}
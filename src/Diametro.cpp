@@ -0,0 +1,262 @@
+#include "../include/Grafo.hpp"
+#include "../include/PoolThreads.hpp"
+using namespace std;
+
+// Diâmetro de grafos sem peso nas arestas por buscas em largura. O maior dos
+// menores caminhos é o maior valor de excentricidade entre os nós (ignorando
+// pares sem caminho), e cada busca em largura fornece a excentricidade exata
+// da sua origem em O(V+E).
+
+int Grafo::busca_largura(int origem, int *dist, int *fila,
+                         bool reverso) const {
+  int ini = 0, fim = 0;
+  dist[origem] = 0;
+  fila[fim++] = origem;
+  while (ini < fim) {
+    int v = fila[ini++];
+    int proxima = dist[v] + 1;
+    auto visita = [&](int w, int) {
+      if (w >= 1 && w <= ordem && dist[w] < 0) {
+        dist[w] = proxima;
+        fila[fim++] = w;
+      }
+      return true;
+    };
+    if (reverso)
+      para_cada_predecessor(v, visita);
+    else
+      para_cada_vizinho(v, visita);
+  }
+  return fim;
+}
+
+// Vetores de trabalho de uma busca em largura. dist fica em -1 entre buscas:
+// limpa() desfaz apenas as posições visitadas pela última busca.
+struct VarreduraBFS {
+  int *dist;
+  int *fila;
+  int visitados;
+  int excentricidade;
+  int maisLonge; // nó mais distante da origem (menor id no empate)
+
+  VarreduraBFS(int n) : dist(new int[n + 1]), fila(new int[n + 1]) {
+    for (int v = 0; v <= n; v++)
+      dist[v] = -1;
+    visitados = 0;
+  }
+  ~VarreduraBFS() {
+    delete[] dist;
+    delete[] fila;
+  }
+  VarreduraBFS(const VarreduraBFS &) = delete;
+  VarreduraBFS &operator=(const VarreduraBFS &) = delete;
+
+  void executa(const Grafo &g, int origem, bool reverso = false) {
+    visitados = g.busca_largura(origem, dist, fila, reverso);
+    excentricidade = dist[fila[visitados - 1]];
+    maisLonge = fila[visitados - 1];
+    for (int i = visitados - 1; i >= 0 && dist[fila[i]] == excentricidade;
+         i--) {
+      if (fila[i] < maisLonge)
+        maisLonge = fila[i];
+    }
+  }
+  void limpa() {
+    for (int i = 0; i < visitados; i++)
+      dist[fila[i]] = -1;
+    visitados = 0;
+  }
+};
+
+// Atualiza o melhor par se a distância for maior (ou igual, com par menor)
+static void considera(Grafo::ResultadoDistancia &res, int a, int b, int d) {
+  if (d <= 0)
+    return;
+  if (d > res.distancia ||
+      (d == res.distancia && (a < res.no1 || (a == res.no1 && b < res.no2)))) {
+    res.no1 = a;
+    res.no2 = b;
+    res.distancia = d;
+  }
+}
+
+static Grafo::ResultadoDistancia resultado_vazio() {
+  Grafo::ResultadoDistancia res = {-1, -1, -1e9, false};
+  return res;
+}
+
+// Executa uma busca em largura a partir de cada nó de origens[0..n) em
+// paralelo e acumula as excentricidades em 'res'. trabalho[t] guarda os
+// vetores da tarefa t, alocados na primeira vez em que são usados.
+static void varredura_paralela(const Grafo &g, const int *origens, int n,
+                               bool naoDirecionado, VarreduraBFS **trabalho,
+                               Grafo::ResultadoDistancia &res) {
+  PoolThreads &pool = PoolThreads::global();
+  int nTarefas = (n < pool.tamanho() ? n : pool.tamanho());
+  Grafo::ResultadoDistancia *parcial = new Grafo::ResultadoDistancia[nTarefas];
+  pool.para_cada(nTarefas, [&](int t) {
+    if (trabalho[t] == nullptr)
+      trabalho[t] = new VarreduraBFS(g.get_ordem());
+    VarreduraBFS &bfs = *trabalho[t];
+    parcial[t] = resultado_vazio();
+    for (int i = t; i < n; i += nTarefas) {
+      int s = origens[i];
+      bfs.executa(g, s);
+      if (naoDirecionado && bfs.maisLonge < s)
+        considera(parcial[t], bfs.maisLonge, s, bfs.excentricidade);
+      else
+        considera(parcial[t], s, bfs.maisLonge, bfs.excentricidade);
+      bfs.limpa();
+    }
+  });
+  for (int t = 0; t < nTarefas; t++)
+    considera(res, parcial[t].no1, parcial[t].no2, (int)parcial[t].distancia);
+  delete[] parcial;
+}
+
+// Diâmetro exato. Em grafos direcionados é feita uma busca a partir de cada
+// nó (O(V·E), sem matriz n x n). Em grafos não direcionados, cada componente
+// é tratada com o iFUB: uma varredura dupla escolhe um nó central u e as
+// camadas da busca a partir de u são processadas da mais distante para a
+// mais próxima; ao terminar a camada i, todo par ainda não examinado está a
+// no máximo 2(i-1) de distância, e o algoritmo para quando esse limite fica
+// abaixo do maior valor encontrado. Na prática poucas buscas são necessárias.
+// Como os empates também são examinados (toda busca registra o menor par da
+// sua origem), o par retornado é o primeiro à distância máxima na ordem das
+// linhas, o mesmo do Floyd–Warshall.
+Grafo::ResultadoDistancia Grafo::distancia_bfs_exata() const {
+  int n = get_ordem();
+  ResultadoDistancia res = resultado_vazio();
+  int nTrabalho = PoolThreads::global().tamanho();
+  VarreduraBFS **trabalho = new VarreduraBFS *[nTrabalho];
+  for (int t = 0; t < nTrabalho; t++)
+    trabalho[t] = nullptr;
+
+  if (direcionado) {
+    int *origens = new int[n];
+    for (int v = 0; v < n; v++)
+      origens[v] = v + 1;
+    varredura_paralela(*this, origens, n, false, trabalho, res);
+    delete[] origens;
+  } else {
+    VarreduraBFS a(n), centro(n);
+    bool *visto = new bool[n + 1];
+    for (int v = 0; v <= n; v++)
+      visto[v] = false;
+    for (int s = 1; s <= n; s++) {
+      if (visto[s])
+        continue;
+      // Primeira varredura: descobre a componente e um nó periférico
+      a.executa(*this, s);
+      for (int i = 0; i < a.visitados; i++)
+        visto[a.fila[i]] = true;
+      int tamanho = a.visitados;
+      int periferico = a.maisLonge;
+      a.limpa();
+      if (tamanho - 1 < res.distancia)
+        continue; // a componente não pode alcançar o valor atual
+
+      // Segunda varredura e nó central: meio do caminho até o mais distante
+      a.executa(*this, periferico);
+      considera(res, (periferico < a.maisLonge ? periferico : a.maisLonge),
+                (periferico < a.maisLonge ? a.maisLonge : periferico),
+                a.excentricidade);
+      int u = a.maisLonge;
+      for (int passos = a.excentricidade / 2; passos > 0; passos--) {
+        int alvo = a.dist[u] - 1;
+        para_cada_vizinho(u, [&](int w, int) {
+          if (w >= 1 && w <= n && a.dist[w] == alvo) {
+            u = w;
+            return false;
+          }
+          return true;
+        });
+      }
+      a.limpa();
+
+      centro.executa(*this, u);
+      considera(res, (u < centro.maisLonge ? u : centro.maisLonge),
+                (u < centro.maisLonge ? centro.maisLonge : u),
+                centro.excentricidade);
+      // Camadas da mais distante para a mais próxima; a fila da busca está em
+      // ordem de distância, então cada camada é um trecho contíguo
+      int fim = centro.visitados;
+      for (int i = centro.excentricidade; i >= 1 && 2 * i >= res.distancia;
+           i--) {
+        int ini = fim;
+        while (ini > 0 && centro.dist[centro.fila[ini - 1]] == i)
+          ini--;
+        varredura_paralela(*this, centro.fila + ini, fim - ini, true,
+                           trabalho, res);
+        fim = ini;
+      }
+      centro.limpa();
+    }
+    delete[] visto;
+  }
+
+  for (int t = 0; t < nTrabalho; t++)
+    delete trabalho[t];
+  delete[] trabalho;
+  return res;
+}
+
+// Limite inferior do diâmetro com varredurasDiametro buscas em largura: cada
+// busca parte do nó mais distante encontrado pela anterior (em grafos
+// direcionados as buscas alternam entre arestas diretas e reversas). O par
+// retornado é sempre um par real de nós com a distância informada.
+Grafo::ResultadoDistancia Grafo::distancia_bfs_aproximada() const {
+  int n = get_ordem();
+  int k = (varredurasDiametro > 0 ? varredurasDiametro : 1);
+  ResultadoDistancia res = resultado_vazio();
+  VarreduraBFS bfs(n);
+
+  if (direcionado) {
+    // Começa pelo nó de maior grau de saída
+    int r = 1;
+    for (int v = 2; v <= n; v++) {
+      if (get_grau_saida(v) > get_grau_saida(r))
+        r = v;
+    }
+    bool reverso = false;
+    for (int i = 0; i < k; i++) {
+      bfs.executa(*this, r, reverso);
+      if (reverso)
+        considera(res, bfs.maisLonge, r, bfs.excentricidade);
+      else
+        considera(res, r, bfs.maisLonge, bfs.excentricidade);
+      r = bfs.maisLonge;
+      bfs.limpa();
+      reverso = !reverso;
+    }
+    return res;
+  }
+
+  // Não direcionado: k varreduras em cada componente que ainda possa superar
+  // o valor atual (a primeira busca também descobre a componente)
+  bool *visto = new bool[n + 1];
+  for (int v = 0; v <= n; v++)
+    visto[v] = false;
+  for (int s = 1; s <= n; s++) {
+    if (visto[s])
+      continue;
+    int r = s;
+    for (int i = 0; i < k; i++) {
+      bfs.executa(*this, r);
+      if (i == 0) {
+        for (int j = 0; j < bfs.visitados; j++)
+          visto[bfs.fila[j]] = true;
+        if (bfs.visitados - 1 <= res.distancia) {
+          bfs.limpa();
+          break;
+        }
+      }
+      considera(res, (r < bfs.maisLonge ? r : bfs.maisLonge),
+                (r < bfs.maisLonge ? bfs.maisLonge : r), bfs.excentricidade);
+      r = bfs.maisLonge;
+      bfs.limpa();
+    }
+  }
+  delete[] visto;
+  return res;
+}
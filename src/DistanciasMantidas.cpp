@@ -0,0 +1,187 @@
+#include "../include/DistanciasMantidas.hpp"
+#include "../include/FloydWarshall.hpp"
+#include "../include/PoolThreads.hpp"
+using namespace std;
+
+const double INF = 1e9;
+// Distâncias acima deste limite são tratadas como ausência de caminho (somas
+// envolvendo INF e pesos negativos podem ficar pouco abaixo de INF)
+const double LIMITE_INF = INF / 2;
+
+DistanciasMantidas::DistanciasMantidas()
+    : dist(nullptr), capacidade(0), maiorDaLinha(nullptr),
+      colunaDaMaior(nullptr), cicloNegativo(false) {}
+
+DistanciasMantidas::~DistanciasMantidas() { invalida(); }
+
+int DistanciasMantidas::ordem() const { return (dist ? dist->n : 0); }
+
+void DistanciasMantidas::invalida() {
+  delete dist;
+  delete[] maiorDaLinha;
+  delete[] colunaDaMaior;
+  dist = nullptr;
+  maiorDaLinha = nullptr;
+  colunaDaMaior = nullptr;
+  capacidade = 0;
+  cicloNegativo = false;
+}
+
+void DistanciasMantidas::recalcula_linha(int i) {
+  const double *di = dist->linha(i);
+  double maior = -1e9;
+  int coluna = -1;
+  for (int j = 0; j < dist->n; j++) {
+    if (j != i && di[j] < LIMITE_INF && di[j] > maior) {
+      maior = di[j];
+      coluna = j;
+    }
+  }
+  maiorDaLinha[i] = maior;
+  colunaDaMaior[i] = coluna;
+}
+
+void DistanciasMantidas::inicia(MatrizDistancias *calculada) {
+  invalida();
+  dist = calculada;
+  capacidade = calculada->passo;
+  maiorDaLinha = new double[capacidade];
+  colunaDaMaior = new int[capacidade];
+  // Um ciclo negativo aparece como distância negativa de um nó a ele mesmo
+  for (int i = 0; i < dist->n; i++) {
+    if (dist->linha(i)[i] < 0)
+      cicloNegativo = true;
+    recalcula_linha(i);
+  }
+}
+
+void DistanciasMantidas::adiciona_no() {
+  if (dist == nullptr)
+    return;
+  int n = dist->n;
+  if (n == capacidade) {
+    // Capacidade dobrada: a cópia custa O(n²) amortizado
+    MatrizDistancias *nova = new MatrizDistancias(2 * capacidade + 4, INF);
+    nova->n = n;
+    for (int i = 0; i < n; i++) {
+      const double *orig = dist->linha(i);
+      double *dest = nova->linha(i);
+      for (int j = 0; j < n; j++)
+        dest[j] = orig[j];
+    }
+    double *novoMaior = new double[nova->passo];
+    int *novaColuna = new int[nova->passo];
+    for (int i = 0; i < n; i++) {
+      novoMaior[i] = maiorDaLinha[i];
+      novaColuna[i] = colunaDaMaior[i];
+    }
+    delete dist;
+    delete[] maiorDaLinha;
+    delete[] colunaDaMaior;
+    dist = nova;
+    maiorDaLinha = novoMaior;
+    colunaDaMaior = novaColuna;
+    capacidade = nova->passo;
+  }
+  // O Floyd–Warshall blocado também relaxa o padding, que pode ter ficado
+  // pouco abaixo de INF: a linha e a coluna do novo nó são refeitas
+  double *linhaNova = dist->linha(n);
+  for (int j = 0; j < n; j++) {
+    linhaNova[j] = INF;
+    dist->linha(j)[n] = INF;
+  }
+  linhaNova[n] = 0;
+  dist->n = n + 1;
+  maiorDaLinha[n] = -1e9;
+  colunaDaMaior[n] = -1;
+}
+
+void DistanciasMantidas::relaxa(int origem, int destino, double peso,
+                                bool direcionado, PoolThreads &pool) {
+  if (dist == nullptr || cicloNegativo)
+    return;
+  int n = dist->n;
+  int u = origem - 1;
+  int v = destino - 1;
+  if (u < 0 || u >= n || v < 0 || v >= n || u == v)
+    return;
+  // A aresta fecha um ciclo negativo se a volta de v a u somada a ela for
+  // negativa (em grafos não direcionados, basta o peso ser negativo)
+  if (peso + dist->linha(v)[u] < 0 || (!direcionado && peso < 0)) {
+    cicloNegativo = true;
+    return;
+  }
+  // Sem melhorar d[u][v] (e d[v][u]), nenhum caminho melhora
+  if (peso >= dist->linha(u)[v] &&
+      (direcionado || peso >= dist->linha(v)[u]))
+    return;
+
+  // Cópias da linha e da coluna de u e de v, lidas por todas as linhas
+  double *colunaU = new double[n];
+  double *colunaV = new double[n];
+  double *linhaU = new double[n];
+  double *linhaV = new double[n];
+  for (int i = 0; i < n; i++) {
+    colunaU[i] = dist->linha(i)[u];
+    colunaV[i] = dist->linha(i)[v];
+    linhaU[i] = dist->linha(u)[i];
+    linhaV[i] = dist->linha(v)[i];
+  }
+
+  int nTarefas = pool.tamanho() * 4;
+  if (nTarefas > n)
+    nTarefas = n;
+  pool.para_cada(nTarefas, [&](int t) {
+    int ini = (int)((long long)n * t / nTarefas);
+    int fim = (int)((long long)n * (t + 1) / nTarefas);
+    for (int i = ini; i < fim; i++) {
+      double *di = dist->linha(i);
+      bool alterou = false;
+      // Caminhos i -> u -> v -> j
+      double ate = colunaU[i] + peso;
+      if (colunaU[i] < LIMITE_INF) {
+        for (int j = 0; j < n; j++) {
+          if (linhaV[j] < LIMITE_INF && ate + linhaV[j] < di[j]) {
+            di[j] = ate + linhaV[j];
+            alterou = true;
+          }
+        }
+      }
+      // Caminhos i -> v -> u -> j (a aresta no sentido contrário)
+      ate = colunaV[i] + peso;
+      if (!direcionado && colunaV[i] < LIMITE_INF) {
+        for (int j = 0; j < n; j++) {
+          if (linhaU[j] < LIMITE_INF && ate + linhaU[j] < di[j]) {
+            di[j] = ate + linhaU[j];
+            alterou = true;
+          }
+        }
+      }
+      if (alterou)
+        recalcula_linha(i);
+    }
+  });
+
+  delete[] colunaU;
+  delete[] colunaV;
+  delete[] linhaU;
+  delete[] linhaV;
+}
+
+bool DistanciasMantidas::maior_distancia(int &no1, int &no2,
+                                         double &distancia) const {
+  if (dist == nullptr)
+    return false;
+  int melhor = -1;
+  for (int i = 0; i < dist->n; i++) {
+    if (colunaDaMaior[i] >= 0 &&
+        (melhor < 0 || maiorDaLinha[i] > maiorDaLinha[melhor]))
+      melhor = i;
+  }
+  if (melhor < 0)
+    return false;
+  no1 = melhor + 1;
+  no2 = colunaDaMaior[melhor] + 1;
+  distancia = maiorDaLinha[melhor];
+  return true;
+}
@@ -0,0 +1,138 @@
+#include "../include/FloydWarshall.hpp"
+#include <cstdlib>
+#include <new>
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+using namespace std;
+
+// Lado dos blocos (em elementos); 3 blocos de 64x64 doubles cabem na cache L2
+static const int TAM_BLOCO = 64;
+static const int ALINHAMENTO = 64;
+
+static double *aloca_alinhado(size_t bytes) {
+  void *p = nullptr;
+#if defined(_WIN32)
+  p = _aligned_malloc(bytes, ALINHAMENTO);
+#else
+  if (posix_memalign(&p, ALINHAMENTO, bytes) != 0)
+    p = nullptr;
+#endif
+  if (!p)
+    throw bad_alloc();
+  return (double *)p;
+}
+
+static void libera_alinhado(double *p) {
+#if defined(_WIN32)
+  _aligned_free(p);
+#else
+  free(p);
+#endif
+}
+
+// Passo das linhas: múltiplo do bloco (ou de 4, para matrizes pequenas)
+static int calcula_passo(int n) {
+  if (n <= TAM_BLOCO)
+    return (n + 3) / 4 * 4;
+  return (n + TAM_BLOCO - 1) / TAM_BLOCO * TAM_BLOCO;
+}
+
+MatrizDistancias::MatrizDistancias(int n, double inf)
+    : dados(nullptr), n(n), passo(calcula_passo(n)) {
+  size_t total = (size_t)passo * passo;
+  dados = aloca_alinhado((total == 0 ? 1 : total) * sizeof(double));
+  for (size_t i = 0; i < total; i++)
+    dados[i] = inf;
+  for (int i = 0; i < passo; i++)
+    dados[(size_t)i * passo + i] = 0;
+}
+
+MatrizDistancias::~MatrizDistancias() { libera_alinhado(dados); }
+
+void floyd_warshall_escalar(MatrizDistancias &dist) {
+  int n = dist.n;
+  for (int k = 0; k < n; k++) {
+    const double *dk = dist.linha(k);
+    for (int i = 0; i < n; i++) {
+      double *di = dist.linha(i);
+      for (int j = 0; j < n; j++) {
+        if (di[k] + dk[j] < di[j])
+          di[j] = di[k] + dk[j];
+      }
+    }
+  }
+}
+
+// di[j] = min(di[j], dik + dk[j]) para j em [0, tam); tam é múltiplo de 4.
+// di e dk são a mesma linha quando i == k, e cada posição é lida antes de
+// ser gravada, então o resultado não depende dessa sobreposição.
+static inline void relaxa_linha(double *di, const double *dk, double dik,
+                                int tam) {
+  int j = 0;
+#if defined(__AVX__)
+  __m256d vik = _mm256_set1_pd(dik);
+  for (; j + 4 <= tam; j += 4) {
+    __m256d soma = _mm256_add_pd(vik, _mm256_loadu_pd(dk + j));
+    _mm256_storeu_pd(di + j, _mm256_min_pd(_mm256_loadu_pd(di + j), soma));
+  }
+#elif defined(__SSE2__)
+  __m128d vik = _mm_set1_pd(dik);
+  for (; j + 2 <= tam; j += 2) {
+    __m128d soma = _mm_add_pd(vik, _mm_loadu_pd(dk + j));
+    _mm_storeu_pd(di + j, _mm_min_pd(_mm_loadu_pd(di + j), soma));
+  }
+#endif
+  for (; j < tam; j++) {
+    double soma = dik + dk[j];
+    if (soma < di[j])
+      di[j] = soma;
+  }
+}
+
+// Atualiza o bloco (bi, bj) usando os caminhos que passam pelos nós do bloco
+// bk. Quando o bloco atualizado é o próprio bloco da linha/coluna k, a ordem
+// k -> i -> j garante o mesmo resultado do algoritmo tradicional.
+static void atualiza_bloco(MatrizDistancias &dist, int bi, int bj, int bk,
+                           int tam) {
+  int i0 = bi * tam, j0 = bj * tam, k0 = bk * tam;
+  for (int k = k0; k < k0 + tam; k++) {
+    const double *dk = dist.linha(k) + j0;
+    for (int i = i0; i < i0 + tam; i++) {
+      double *di = dist.linha(i);
+      relaxa_linha(di + j0, dk, di[k], tam);
+    }
+  }
+}
+
+void floyd_warshall_blocado(MatrizDistancias &dist, PoolThreads &pool) {
+  int tam = (dist.passo < TAM_BLOCO ? dist.passo : TAM_BLOCO);
+  if (tam == 0)
+    return;
+  int nb = dist.passo / tam;
+  for (int bk = 0; bk < nb; bk++) {
+    // Fase 1: bloco diagonal
+    atualiza_bloco(dist, bk, bk, bk, tam);
+
+    // Fase 2: blocos da linha bk e da coluna bk
+    pool.para_cada(2 * (nb - 1), [&dist, bk, nb, tam](int t) {
+      int outro = t % (nb - 1);
+      if (outro >= bk)
+        outro++;
+      if (t < nb - 1)
+        atualiza_bloco(dist, bk, outro, bk, tam);
+      else
+        atualiza_bloco(dist, outro, bk, bk, tam);
+    });
+
+    // Fase 3: demais blocos (uma tarefa por linha de blocos)
+    pool.para_cada(nb, [&dist, bk, nb, tam](int bi) {
+      if (bi == bk)
+        return;
+      for (int bj = 0; bj < nb; bj++) {
+        if (bj != bk)
+          atualiza_bloco(dist, bi, bj, bk, tam);
+      }
+    });
+  }
+}
@@ -0,0 +1,270 @@
+#include "../include/FormatoBinario.hpp"
+#include "../include/ArquivoMapeado.hpp"
+#include "../include/Grafo.hpp"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+using namespace std;
+
+// Ordena (de forma estável) os índices de 'entrada' pela chave informada,
+// usando counting sort com chaves em [0, nChaves)
+static void ordena_por_chave(const int *chave, const int *entrada, int *saida,
+                             int total, int nChaves) {
+  int *cont = new int[nChaves + 1];
+  for (int i = 0; i <= nChaves; i++)
+    cont[i] = 0;
+  for (int i = 0; i < total; i++)
+    cont[chave[entrada[i]] + 1]++;
+  for (int i = 0; i < nChaves; i++)
+    cont[i + 1] += cont[i];
+  for (int i = 0; i < total; i++)
+    saida[cont[chave[entrada[i]]]++] = entrada[i];
+  delete[] cont;
+}
+
+// Grava 'bytes' bytes e completa com zeros até a próxima posição alinhada
+static bool grava_secao(FILE *arquivo, const void *dados, size_t bytes) {
+  static const char zeros[8] = {0};
+  if (bytes > 0 && fwrite(dados, 1, bytes, arquivo) != bytes)
+    return false;
+  size_t resto = LayoutBinario::alinha(bytes) - bytes;
+  return resto == 0 || fwrite(zeros, 1, resto, arquivo) == resto;
+}
+
+// Gera um CSR (offsets, valores e pesos) com as entradas agrupadas por
+// 'linha' e, dentro de cada linha, ordenadas por 'coluna'
+static void monta_csr(const int *linha, const int *coluna, const int *peso,
+                      int total, int n, int *offsets, int *valores,
+                      int *pesos) {
+  int *idx = new int[total > 0 ? total : 1];
+  int *aux = new int[total > 0 ? total : 1];
+  for (int i = 0; i < total; i++)
+    idx[i] = i;
+  ordena_por_chave(coluna, idx, aux, total, n);
+  ordena_por_chave(linha, aux, idx, total, n);
+  for (int v = 0; v <= n; v++)
+    offsets[v] = 0;
+  for (int i = 0; i < total; i++) {
+    offsets[linha[idx[i]] + 1]++;
+    valores[i] = coluna[idx[i]];
+    pesos[i] = peso[idx[i]];
+  }
+  for (int v = 0; v < n; v++)
+    offsets[v + 1] += offsets[v];
+  delete[] idx;
+  delete[] aux;
+}
+
+bool Grafo::salva_binario(const string &nomeArquivo) const {
+  garante_compacto();
+  int n = ordem;
+  // Entradas (origem, destino, peso), 0-based. Arestas para ids sem nó
+  // (possíveis em grafos direcionados na GrafoLista) não são gravadas.
+  int total = 0;
+  for (int v = 1; v <= n; v++) {
+    para_cada_vizinho(v, [&](int w, int) {
+      if (w >= 1 && w <= n)
+        total++;
+      return true;
+    });
+  }
+  int *o = new int[total > 0 ? total : 1];
+  int *d = new int[total > 0 ? total : 1];
+  int *p = new int[total > 0 ? total : 1];
+  int k = 0;
+  for (int v = 1; v <= n; v++) {
+    para_cada_vizinho(v, [&](int w, int peso) {
+      if (w >= 1 && w <= n) {
+        o[k] = v - 1;
+        d[k] = w - 1;
+        p[k] = peso;
+        k++;
+      }
+      return true;
+    });
+  }
+
+  CabecalhoBinario cabecalho;
+  memset(&cabecalho, 0, sizeof(cabecalho));
+  memcpy(cabecalho.assinatura, ASSINATURA_BINARIO, sizeof(ASSINATURA_BINARIO));
+  cabecalho.versao = VERSAO_BINARIO;
+  cabecalho.marcaOrdemBytes = MARCA_ORDEM_BYTES;
+  cabecalho.flags = (direcionado ? BINARIO_DIRECIONADO : 0) |
+                    (ponderadoVertices ? BINARIO_PONDERADO_VERTICES : 0) |
+                    (ponderadoArestas ? BINARIO_PONDERADO_ARESTAS : 0);
+  cabecalho.ordem = n;
+  cabecalho.nEntradas = total;
+
+  int *pesosVertices = new int[n > 0 ? n : 1];
+  for (int v = 1; v <= n; v++)
+    pesosVertices[v - 1] = get_peso_vertice(v);
+  int *offsets = new int[n + 1];
+  int *destinos = new int[total > 0 ? total : 1];
+  int *pesos = new int[total > 0 ? total : 1];
+  monta_csr(o, d, p, total, n, offsets, destinos, pesos);
+
+  bool ok = false;
+  FILE *arquivo = fopen(nomeArquivo.c_str(), "wb");
+  if (arquivo != nullptr) {
+    ok = grava_secao(arquivo, &cabecalho, sizeof(cabecalho)) &&
+         grava_secao(arquivo, pesosVertices, sizeof(int) * (size_t)n) &&
+         grava_secao(arquivo, offsets, sizeof(int) * ((size_t)n + 1)) &&
+         grava_secao(arquivo, destinos, sizeof(int) * (size_t)total) &&
+         grava_secao(arquivo, pesos, sizeof(int) * (size_t)total);
+    if (ok && direcionado) {
+      monta_csr(d, o, p, total, n, offsets, destinos, pesos);
+      ok = grava_secao(arquivo, offsets, sizeof(int) * ((size_t)n + 1)) &&
+           grava_secao(arquivo, destinos, sizeof(int) * (size_t)total) &&
+           grava_secao(arquivo, pesos, sizeof(int) * (size_t)total);
+    }
+    ok = (fclose(arquivo) == 0) && ok;
+  }
+  if (!ok)
+    cerr << "Erro ao gravar o arquivo " << nomeArquivo << "\n";
+
+  delete[] o;
+  delete[] d;
+  delete[] p;
+  delete[] pesosVertices;
+  delete[] offsets;
+  delete[] destinos;
+  delete[] pesos;
+  return ok;
+}
+
+bool Grafo::eh_arquivo_binario(const string &nomeArquivo) {
+  char assinatura[sizeof(ASSINATURA_BINARIO)];
+  FILE *arquivo = fopen(nomeArquivo.c_str(), "rb");
+  if (arquivo == nullptr)
+    return false;
+  size_t lidos = fread(assinatura, 1, sizeof(assinatura), arquivo);
+  fclose(arquivo);
+  return lidos == sizeof(assinatura) &&
+         memcmp(assinatura, ASSINATURA_BINARIO, sizeof(assinatura)) == 0;
+}
+
+// offsets[0..n] deve começar em 0, não decrescer e terminar em total
+static bool offsets_validos(const int32_t *offsets, int n, int64_t total) {
+  if (offsets[0] != 0 || offsets[n] != total)
+    return false;
+  for (int v = 0; v < n; v++) {
+    if (offsets[v + 1] < offsets[v])
+      return false;
+  }
+  return true;
+}
+
+// Cada linha de valores[offsets[v]..offsets[v+1]) deve ter índices de
+// vértices em [0, n) e estritamente crescentes; offsets já validados
+static bool linhas_validas(const int32_t *offsets, const int32_t *valores,
+                           int n) {
+  for (int v = 0; v < n; v++) {
+    for (int32_t e = offsets[v]; e < offsets[v + 1]; e++) {
+      if (valores[e] < 0 || valores[e] >= n ||
+          (e > offsets[v] && valores[e] <= valores[e - 1]))
+        return false;
+    }
+  }
+  return true;
+}
+
+const CabecalhoBinario *Grafo::abre_binario(ArquivoMapeado &arquivo,
+                                            const string &nomeArquivo) {
+  if (!arquivo.abre(nomeArquivo)) {
+    cerr << "Erro ao abrir o arquivo " << nomeArquivo << "\n";
+    return nullptr;
+  }
+  const char *base = arquivo.inicio();
+  const CabecalhoBinario *cabecalho = (const CabecalhoBinario *)base;
+  const char *erro = nullptr;
+  if (arquivo.tamanho() < sizeof(CabecalhoBinario) ||
+      memcmp(cabecalho->assinatura, ASSINATURA_BINARIO,
+             sizeof(ASSINATURA_BINARIO)) != 0)
+    erro = "não é um grafo binário";
+  else if (cabecalho->marcaOrdemBytes != MARCA_ORDEM_BYTES)
+    erro = "gravado com outra ordem de bytes";
+  else if (cabecalho->versao != VERSAO_BINARIO)
+    erro = "versão não suportada";
+  else if (cabecalho->ordem < 0 || cabecalho->nEntradas < 0 ||
+           cabecalho->nEntradas > 2147483647LL || cabecalho->flags > 7)
+    erro = "cabeçalho inválido";
+  if (erro == nullptr) {
+    int n = cabecalho->ordem;
+    bool dir = (cabecalho->flags & BINARIO_DIRECIONADO) != 0;
+    LayoutBinario layout(n, (int)cabecalho->nEntradas, dir);
+    if (arquivo.tamanho() < layout.total)
+      erro = "arquivo truncado";
+    else if (!offsets_validos((const int32_t *)(base + layout.offsets), n,
+                              cabecalho->nEntradas) ||
+             (dir && !offsets_validos((const int32_t *)(base + layout.roffsets),
+                                      n, cabecalho->nEntradas)))
+      erro = "offsets inválidos";
+    else if (!linhas_validas((const int32_t *)(base + layout.offsets),
+                             (const int32_t *)(base + layout.destinos), n) ||
+             (dir &&
+              !linhas_validas((const int32_t *)(base + layout.roffsets),
+                              (const int32_t *)(base + layout.rorigens), n)))
+      erro = "vértices inválidos nas arestas";
+  }
+  if (erro != nullptr) {
+    cerr << "Erro: " << nomeArquivo << ": " << erro << ".\n";
+    arquivo.fecha();
+    return nullptr;
+  }
+  return cabecalho;
+}
+
+// Implementação genérica: insere os vértices e as arestas (cada aresta uma
+// vez, na ordem das linhas) pela interface comum das estruturas
+bool Grafo::carrega_binario(const string &nomeArquivo) {
+  INSTRUMENTA(OP_CARREGA_BINARIO);
+  ArquivoMapeado arquivo;
+  const CabecalhoBinario *cabecalho = abre_binario(arquivo, nomeArquivo);
+  if (cabecalho == nullptr)
+    return false;
+  int n = cabecalho->ordem;
+  int nEntradas = (int)cabecalho->nEntradas;
+  ordem = n;
+  direcionado = (cabecalho->flags & BINARIO_DIRECIONADO) != 0;
+  ponderadoVertices = (cabecalho->flags & BINARIO_PONDERADO_VERTICES) != 0;
+  ponderadoArestas = (cabecalho->flags & BINARIO_PONDERADO_ARESTAS) != 0;
+  LayoutBinario layout(n, nEntradas, direcionado);
+  const char *base = arquivo.inicio();
+  const int *pesosVertices = (const int *)(base + layout.pesosVertices);
+  const int *offsets = (const int *)(base + layout.offsets);
+  const int *destinos = (const int *)(base + layout.destinos);
+  const int *pesos = (const int *)(base + layout.pesos);
+
+  int nArestas = (direcionado ? nEntradas : nEntradas / 2);
+  reserva(n, nArestas);
+  for (int v = 1; v <= n; v++)
+    inserir_vertice(v, pesosVertices[v - 1]);
+  int *origens = new int[nEntradas > 0 ? nEntradas : 1];
+  int *dests = new int[nEntradas > 0 ? nEntradas : 1];
+  int *ps = new int[nEntradas > 0 ? nEntradas : 1];
+  int k = 0;
+  for (int v = 0; v < n; v++) {
+    for (int e = offsets[v]; e < offsets[v + 1]; e++) {
+      if (!direcionado && destinos[e] < v)
+        continue;
+      origens[k] = v + 1;
+      dests[k] = destinos[e] + 1;
+      ps[k] = pesos[e];
+      k++;
+    }
+  }
+  agrupaRecusas = true;
+  arestasRecusadas = 0;
+  inserir_arestas_lote(origens, dests, ps, k);
+  fim_carga();
+  agrupaRecusas = false;
+  if (arestasRecusadas > 0)
+    cerr << "Aviso: " << arestasRecusadas
+         << " aresta(s) recusada(s) durante a carga (laços, repetidas ou com "
+            "vértices inexistentes).\n";
+  arestasRecusadas = 0;
+  delete[] origens;
+  delete[] dests;
+  delete[] ps;
+  return true;
+}
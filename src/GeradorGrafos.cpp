@@ -0,0 +1,223 @@
+#include "../include/GeradorGrafos.hpp"
+#include <cmath>
+#include <cstdio>
+using namespace std;
+
+GeradorGrafos::GeradorGrafos(unsigned long long semente) : estado(semente) {}
+
+unsigned long long GeradorGrafos::proximo() {
+  unsigned long long z = (estado += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+double GeradorGrafos::uniforme() {
+  // 53 bits: todos os valores são representáveis exatamente em double
+  return (double)(proximo() >> 11) / 9007199254740992.0;
+}
+
+int GeradorGrafos::inteiro(int limite) {
+  return (int)(proximo() % (unsigned long long)limite);
+}
+
+// Vetores de arestas que crescem por dobra da capacidade
+struct AcumuladorArestas {
+  GeradorGrafos::Arestas &saida;
+  GeradorGrafos &sorteio;
+  int capacidade;
+
+  AcumuladorArestas(GeradorGrafos::Arestas &saida, GeradorGrafos &sorteio,
+                    int n, long long previstas)
+      : saida(saida), sorteio(sorteio), capacidade(0) {
+    delete[] saida.origens;
+    delete[] saida.destinos;
+    delete[] saida.pesos;
+    saida.origens = saida.destinos = saida.pesos = nullptr;
+    saida.n = n;
+    saida.m = 0;
+    cresce(previstas > 16 ? previstas : 16);
+  }
+
+  void cresce(long long nova) {
+    int *o = new int[nova];
+    int *d = new int[nova];
+    int *p = new int[nova];
+    for (int i = 0; i < saida.m; i++) {
+      o[i] = saida.origens[i];
+      d[i] = saida.destinos[i];
+      p[i] = saida.pesos[i];
+    }
+    delete[] saida.origens;
+    delete[] saida.destinos;
+    delete[] saida.pesos;
+    saida.origens = o;
+    saida.destinos = d;
+    saida.pesos = p;
+    capacidade = (int)nova;
+  }
+
+  // Nós 0-based
+  void adiciona(int origem, int destino) {
+    if (saida.m == capacidade)
+      cresce(2LL * capacidade);
+    saida.origens[saida.m] = origem + 1;
+    saida.destinos[saida.m] = destino + 1;
+    saida.pesos[saida.m] = sorteio.inteiro(100) + 1;
+    saida.m++;
+  }
+};
+
+void GeradorGrafos::gera(Modelo modelo, int n, double parametro,
+                         bool direcionado, Arestas &saida) {
+  if (n < 0)
+    n = 0;
+  long long pares = (long long)n * (n - 1) / (direcionado ? 1 : 2);
+  switch (modelo) {
+  case ERDOS_RENYI: {
+    double p = parametro;
+    AcumuladorArestas acc(saida, *this, n, (long long)(pares * p * 1.1));
+    if (p <= 0 || n < 2)
+      break;
+    // Sem percorrer os O(n²) pares: o salto até o próximo par sorteado segue
+    // uma distribuição geométrica (Batagelj e Brandes)
+    double logQ = (p < 1 ? log(1 - p) : 0);
+    for (long long k = -1;;) {
+      k += 1;
+      if (p < 1)
+        k += (long long)floor(log(1 - uniforme()) / logQ);
+      if (k >= pares)
+        break;
+      if (direcionado) {
+        // Par ordenado k: origem k / (n - 1), destino pulando a origem
+        int u = (int)(k / (n - 1));
+        int v = (int)(k % (n - 1));
+        acc.adiciona(u, v >= u ? v + 1 : v);
+      } else {
+        // Par k em ordem lexicográfica de (v, u) com u < v
+        int v = (int)((1 + sqrt(1 + 8.0 * k)) / 2);
+        while ((long long)v * (v - 1) / 2 > k)
+          v--;
+        while ((long long)(v + 1) * v / 2 <= k)
+          v++;
+        acc.adiciona((int)(k - (long long)v * (v - 1) / 2), v);
+      }
+    }
+    break;
+  }
+  case GRADE: {
+    AcumuladorArestas acc(saida, *this, n, 2LL * n);
+    int lado = (int)ceil(sqrt((double)n));
+    for (int i = 0; i < n; i++) {
+      if ((i + 1) % lado != 0 && i + 1 < n)
+        acc.adiciona(i, i + 1);
+      if (i + lado < n)
+        acc.adiciona(i, i + lado);
+    }
+    break;
+  }
+  case CAMINHO: {
+    AcumuladorArestas acc(saida, *this, n, n);
+    for (int i = 0; i + 1 < n; i++)
+      acc.adiciona(i, i + 1);
+    break;
+  }
+  case PREFERENCIAL: {
+    int k = (parametro >= 1 ? (int)parametro : 1);
+    AcumuladorArestas acc(saida, *this, n, (long long)n * k);
+    // Cada extremidade de aresta aparece uma vez em 'pontas': sortear uma
+    // posição equivale a sortear um nó com probabilidade proporcional ao grau
+    long long capPontas = 2LL * n * k + 2;
+    int *pontas = new int[capPontas];
+    long long nPontas = 0;
+    int *escolhidos = new int[k];
+    // Núcleo inicial: os k + 1 primeiros nós formam uma estrela
+    for (int v = 1; v <= k && v < n; v++) {
+      acc.adiciona(v, 0);
+      pontas[nPontas++] = v;
+      pontas[nPontas++] = 0;
+    }
+    for (int v = k + 1; v < n; v++) {
+      for (int j = 0; j < k; j++) {
+        int alvo;
+        bool repetido;
+        do {
+          alvo = pontas[proximo() % (unsigned long long)nPontas];
+          repetido = false;
+          for (int t = 0; t < j; t++)
+            repetido = repetido || (escolhidos[t] == alvo);
+        } while (repetido);
+        escolhidos[j] = alvo;
+      }
+      for (int j = 0; j < k; j++) {
+        acc.adiciona(v, escolhidos[j]);
+        pontas[nPontas++] = v;
+        pontas[nPontas++] = escolhidos[j];
+      }
+    }
+    delete[] escolhidos;
+    delete[] pontas;
+    break;
+  }
+  case COMPLETO: {
+    AcumuladorArestas acc(saida, *this, n, pares);
+    for (int u = 0; u < n; u++)
+      for (int v = (direcionado ? 0 : u + 1); v < n; v++)
+        if (u != v)
+          acc.adiciona(u, v);
+    break;
+  }
+  }
+}
+
+bool GeradorGrafos::salva(const string &nomeArquivo, Modelo modelo, int n,
+                          double parametro, bool direcionado,
+                          bool ponderado) {
+  Arestas arestas;
+  gera(modelo, n, parametro, direcionado, arestas);
+  return salva(nomeArquivo, arestas, direcionado, ponderado);
+}
+
+bool GeradorGrafos::salva(const string &nomeArquivo, const Arestas &arestas,
+                          bool direcionado, bool ponderado) {
+  FILE *f = fopen(nomeArquivo.c_str(), "w");
+  if (f == nullptr)
+    return false;
+  fprintf(f, "%d %d 0 %d\n", arestas.n, direcionado ? 1 : 0, ponderado ? 1 : 0);
+  for (int i = 0; i < arestas.m; i++) {
+    if (ponderado)
+      fprintf(f, "%d %d %d\n", arestas.origens[i], arestas.destinos[i],
+              arestas.pesos[i]);
+    else
+      fprintf(f, "%d %d\n", arestas.origens[i], arestas.destinos[i]);
+  }
+  return fclose(f) == 0;
+}
+
+const char *GeradorGrafos::nome_modelo(Modelo modelo) {
+  switch (modelo) {
+  case ERDOS_RENYI:
+    return "er";
+  case GRADE:
+    return "grade";
+  case CAMINHO:
+    return "caminho";
+  case PREFERENCIAL:
+    return "preferencial";
+  case COMPLETO:
+    return "completo";
+  }
+  return "?";
+}
+
+bool GeradorGrafos::modelo_por_nome(const string &nome, Modelo &modelo) {
+  const Modelo todos[] = {ERDOS_RENYI, GRADE, CAMINHO, PREFERENCIAL,
+                          COMPLETO};
+  for (Modelo m : todos) {
+    if (nome == nome_modelo(m)) {
+      modelo = m;
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,61 @@
+#include "../include/GerenciadorEpocas.hpp"
+#include <thread>
+using namespace std;
+
+GerenciadorEpocas::GerenciadorEpocas() : epocaAtual(1), vagasUsadas(0) {
+  for (int i = 0; i < MAX_LEITORES; i++)
+    vagas[i].epoca.store(0, memory_order_relaxed);
+}
+
+// As operações são sequencialmente consistentes: se avanca() e menor_ativa()
+// não virem a vaga ocupada, a leitura feita depois de entra() já vê o objeto
+// que substituiu o retirado. A época anunciada pode estar atrasada em relação
+// à atual, o que só adia a liberação.
+int GerenciadorEpocas::entra() {
+  // Cada thread recomeça pela última vaga que usou
+  thread_local int dica = -1;
+  if (dica < 0) {
+    static atomic<int> proximaDica(0);
+    dica = proximaDica.fetch_add(1, memory_order_relaxed) % MAX_LEITORES;
+  }
+  while (true) {
+    for (int i = 0; i < MAX_LEITORES; i++) {
+      int vaga = (dica + i) % MAX_LEITORES;
+      if (vagas[vaga].epoca.load(memory_order_relaxed) != 0)
+        continue;
+      // O limite é ampliado antes de ocupar a vaga, para que menor_ativa()
+      // nunca deixe de ver um leitor já registrado
+      int usadas = vagasUsadas.load();
+      while (usadas <= vaga &&
+             !vagasUsadas.compare_exchange_weak(usadas, vaga + 1)) {
+      }
+      uint64_t esperado = 0;
+      if (!vagas[vaga].epoca.compare_exchange_strong(esperado,
+                                                     epocaAtual.load()))
+        continue;
+      dica = vaga;
+      return vaga;
+    }
+    this_thread::yield();
+  }
+}
+
+void GerenciadorEpocas::sai(int vaga) { vagas[vaga].epoca.store(0); }
+
+uint64_t GerenciadorEpocas::avanca() { return epocaAtual.fetch_add(1); }
+
+uint64_t GerenciadorEpocas::menor_ativa() const {
+  uint64_t menor = UINT64_MAX;
+  int usadas = vagasUsadas.load();
+  for (int i = 0; i < usadas; i++) {
+    uint64_t e = vagas[i].epoca.load();
+    if (e != 0 && e < menor)
+      menor = e;
+  }
+  return menor;
+}
+
+GerenciadorEpocas &GerenciadorEpocas::global() {
+  static GerenciadorEpocas gerenciador;
+  return gerenciador;
+}
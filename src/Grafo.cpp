@@ -1,11 +1,19 @@
 #include "../include/Grafo.hpp"
+#include "../include/FloydWarshall.hpp"
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
 using namespace std;
 const double INF = 1e9;
+// Somas envolvendo INF e pesos negativos podem ficar pouco abaixo de INF;
+// distâncias acima deste limite são tratadas como ausência de caminho
+const double LIMITE_INF = INF / 2;
 
-void Grafo::carrega_grafo(const string &nomeArquivo) {
+EstatisticasGrafo Grafo::estatisticas() { return Instrumentacao::leitura(); }
+
+void Grafo::zera_estatisticas() { Instrumentacao::zera(); }
+
+void Grafo::carrega_grafo_stream(const string &nomeArquivo) {
   ifstream arquivo(nomeArquivo.c_str());
   if (!arquivo) {
     cerr << "Erro ao abrir o arquivo " << nomeArquivo << "\n";
@@ -39,139 +47,305 @@ void Grafo::carrega_grafo(const string &nomeArquivo) {
   }
 
   arquivo.close();
+  fim_carga();
+}
+
+int Grafo::get_grau_saida(int vertice) const {
+  int grau = 0;
+  para_cada_vizinho(vertice, [&grau](int, int) {
+    grau++;
+    return true;
+  });
+  return grau;
+}
+
+// Implementação genérica: varre as listas de todos os vértices. As estruturas
+// que mantêm índice reverso sobrescrevem estes métodos.
+int Grafo::get_grau_entrada(int vertice) const {
+  if (!direcionado)
+    return get_grau_saida(vertice);
+  int grau = 0;
+  para_cada_predecessor(vertice, [&grau](int, int) {
+    grau++;
+    return true;
+  });
+  return grau;
+}
+
+void Grafo::percorre_predecessores(int vertice,
+                                   VisitanteVizinhos &visitante) const {
+  if (!direcionado) {
+    percorre_vizinhos(vertice, visitante);
+    return;
+  }
+  bool continua = true;
+  for (int j = 1; j <= ordem && continua; j++) {
+    para_cada_vizinho(j, [&](int destino, int peso) {
+      if (destino == vertice) {
+        continua = visitante.visita(j, peso);
+        return false;
+      }
+      return true;
+    });
+  }
+}
+
+int Grafo::get_num_arestas() const {
+  int total = 0;
+  for (int v = 1; v <= ordem; v++)
+    total += get_grau_saida(v);
+  return (direcionado ? total : total / 2);
+}
+
+IntList Grafo::get_vizinhos(int vertice) const {
+  INSTRUMENTA(OP_GET_VIZINHOS);
+  IntList lista;
+  para_cada_vizinho(vertice, [&lista](int destino, int) {
+    lista.add(destino);
+    return true;
+  });
+  return lista;
 }
 
 // Retorna o grau (ou grau máximo) do grafo.
 // Para grafos direcionados, considera a soma do outdegree e indegree.
 int Grafo::get_grau() const {
+  INSTRUMENTA(OP_GET_GRAU);
   int max_grau = 0;
   for (int i = 1; i <= ordem; i++) {
-    IntList vizinhos = get_vizinhos(i);
-    int out_deg = vizinhos.size();
-    int in_deg = 0;
-    for (int j = 1; j <= ordem; j++) {
-      if (j == i)
-        continue;
-      IntList viz = get_vizinhos(j);
-      for (int k = 0; k < viz.size(); k++) {
-        if (viz.get(k) == i) {
-          in_deg++;
-          break;
-        }
-      }
-    }
-    int total = (direcionado ? (out_deg + in_deg) : out_deg);
+    int out_deg = get_grau_saida(i);
+    int total = (direcionado ? (out_deg + get_grau_entrada(i)) : out_deg);
     if (total > max_grau)
       max_grau = total;
   }
   return max_grau;
 }
 
-// Função auxiliar DFS para marcar os vértices alcançados (desconsidera a
-// direção)
-void dfs_util(const Grafo *g, int v, bool *visitado) {
-  visitado[v] = true;
-  IntList viz = g->get_vizinhos(v);
-  for (int i = 0; i < viz.size(); i++) {
-    int w = viz.get(i);
-    if (!visitado[w])
-      dfs_util(g, w, visitado);
-  }
-  // Para garantir a conectividade em grafos direcionados, varre os vértices que
-  // apontam para v
-  for (int i = 1; i <= g->get_ordem(); i++) {
-    if (!visitado[i]) {
-      IntList viz_i = g->get_vizinhos(i);
-      for (int j = 0; j < viz_i.size(); j++) {
-        if (viz_i.get(j) == v) {
-          dfs_util(g, i, visitado);
-          break;
-        }
-      }
+void Grafo::set_remocao_adiada(bool ativa) {
+  if (!ativa)
+    compacta();
+  remocaoAdiada = ativa;
+}
+
+void Grafo::copia_propriedades(Grafo &destino, const Grafo &origem) {
+  destino.ordem = origem.ordem;
+  destino.direcionado = origem.direcionado;
+  destino.ponderadoVertices = origem.ponderadoVertices;
+  destino.ponderadoArestas = origem.ponderadoArestas;
+}
+
+void Grafo::sincroniza_recusas(Grafo &externo, Grafo &interno) {
+  interno.agrupaRecusas = externo.agrupaRecusas;
+  externo.arestasRecusadas += interno.arestasRecusadas;
+  interno.arestasRecusadas = 0;
+}
+
+int Grafo::posicao_do_id(int id) const {
+  if (removidosPendentes == 0)
+    return id;
+  return posicoesVivas.seleciona(id);
+}
+
+void Grafo::garante_compacto() const {
+  if (removidosPendentes > 0)
+    const_cast<Grafo *>(this)->compacta();
+}
+
+int Grafo::marca_remocoes(const int *ids, int k, int n, bool *removido) {
+  ArvoreFenwick vivas;
+  vivas.reinicia(n);
+  for (int v = 0; v < n; v++)
+    removido[v] = false;
+  int restantes = n;
+  for (int i = 0; i < k; i++) {
+    int pos = (ids[i] >= 1 && ids[i] <= restantes ? vivas.seleciona(ids[i])
+                                                   : -1);
+    if (pos < 0) {
+      cerr << "Erro: Vértice " << ids[i] << " não existe." << endl;
+      continue;
     }
+    vivas.remove(pos);
+    removido[pos - 1] = true;
+    restantes--;
   }
+  return n - restantes;
+}
+
+// Com a remoção adiada ligada durante o lote, cada deleta_no apenas desliga
+// o nó e os ids seguintes são convertidos pela ArvoreFenwick; a renumeração
+// é feita uma vez no final (ou fica pendente, se o modo já estava ligado).
+// Estruturas sem remoção adiada sobrescrevem ou removem um nó por vez.
+void Grafo::deleta_nos(const int *ids, int k) {
+  INSTRUMENTA(OP_DELETA_NOS);
+  bool adiada = remocaoAdiada;
+  remocaoAdiada = true;
+  for (int i = 0; i < k; i++)
+    deleta_no(ids[i]);
+  remocaoAdiada = adiada;
+  if (!adiada)
+    compacta();
+}
+
+void Grafo::deleta_arestas(const int *origens, const int *destinos, int n) {
+  INSTRUMENTA(OP_DELETA_ARESTAS);
+  for (int i = 0; i < n; i++)
+    deleta_aresta(origens[i], destinos[i]);
+}
+
+void Grafo::registra_vertice() {
+  if (componentesValidas)
+    componentes.adiciona();
+  distancias.adiciona_no();
+}
+
+void Grafo::registra_aresta(int origem, int destino, int peso) {
+  distancias.relaxa(origem, destino, peso, direcionado, PoolThreads::global());
+  if (!componentesValidas)
+    return;
+  if (origem < 1 || origem > componentes.tamanho() || destino < 1 ||
+      destino > componentes.tamanho()) {
+    componentesValidas = false;
+    return;
+  }
+  componentes.une(origem - 1, destino - 1);
+}
+
+// Um peso menor equivale a inserir a aresta de novo com o peso novo; um
+// peso maior pode alongar caminhos quaisquer, e a matriz é descartada
+void Grafo::registra_peso(int origem, int destino, int pesoAntigo,
+                          int pesoNovo) {
+  if (pesoNovo < pesoAntigo)
+    distancias.relaxa(origem, destino, pesoNovo, direcionado,
+                      PoolThreads::global());
+  else if (pesoNovo > pesoAntigo)
+    distancias.invalida();
+}
+
+void Grafo::registra_remocao() {
+  componentesValidas = false;
+  distancias.invalida();
+}
+
+void Grafo::set_distancias_mantidas(bool ativa) {
+  manteDistancias = ativa;
+  if (!ativa)
+    distancias.invalida();
 }
 
 // Retorna o número de componentes conexas
 int Grafo::n_conexo() const {
-  bool *visitado = new bool[ordem + 1];
-  for (int i = 0; i <= ordem; i++)
-    visitado[i] = false;
-  int count = 0;
-  for (int i = 1; i <= ordem; i++) {
-    if (!visitado[i]) {
-      dfs_util(this, i, visitado);
-      count++;
+  INSTRUMENTA(OP_N_CONEXO);
+  if (!componentesValidas || componentes.tamanho() != ordem) {
+    // Refaz a union-find percorrendo todas as arestas (sem recursão); como a
+    // união é simétrica, a direção das arestas é desconsiderada
+    componentes.reinicia(ordem);
+    for (int v = 1; v <= ordem; v++) {
+      para_cada_vizinho(v, [this, v](int w, int) {
+        if (w >= 1 && w <= ordem)
+          componentes.une(v - 1, w - 1);
+        return true;
+      });
     }
+    componentesValidas = true;
   }
-  delete[] visitado;
-  return count;
+  return componentes.componentes();
 }
 
 // Verifica se o grafo é completo
 bool Grafo::eh_completo() const {
+  INSTRUMENTA(OP_EH_COMPLETO);
   for (int i = 1; i <= ordem; i++) {
-    IntList viz = get_vizinhos(i);
-    if (!direcionado) {
-      if (viz.size() != ordem - 1)
-        return false;
-    } else {
-      if (viz.size() != ordem - 1)
-        return false;
-      int in_deg = 0;
-      for (int j = 1; j <= ordem; j++) {
-        if (j == i)
-          continue;
-        IntList viz_j = get_vizinhos(j);
-        for (int k = 0; k < viz_j.size(); k++) {
-          if (viz_j.get(k) == i) {
-            in_deg++;
-            break;
-          }
-        }
-      }
-      if (in_deg != ordem - 1)
-        return false;
-    }
+    if (get_grau_saida(i) != ordem - 1)
+      return false;
+    if (direcionado && get_grau_entrada(i) != ordem - 1)
+      return false;
   }
   return true;
 }
 
 Grafo::ResultadoDistancia Grafo::calculaMaiorMenorDistancia() const {
+  INSTRUMENTA(OP_MAIOR_MENOR_DISTANCIA);
+  garante_compacto();
   int n = get_ordem();
-
   if (n <= 0) {
-    ResultadoDistancia res = {-1, -1, -1};
+    ResultadoDistancia res = {-1, -1, -1, false};
     return res;
   }
+  if (manteDistancias)
+    return distancia_mantida();
+  switch (modoDistancia) {
+  case DISTANCIA_FW_ESCALAR:
+    return distancia_floyd_warshall(false);
+  case DISTANCIA_FW_BLOCADO:
+    return distancia_floyd_warshall(true);
+  case DISTANCIA_JOHNSON:
+    return distancia_johnson();
+  case DISTANCIA_BFS_EXATO:
+    if (!ponderadoArestas)
+      return distancia_bfs_exata();
+    break;
+  case DISTANCIA_BFS_APROXIMADO:
+    if (!ponderadoArestas)
+      return distancia_bfs_aproximada();
+    break;
+  default:
+    break;
+  }
+  // Automático. Sem pesos nas arestas, o iFUB costuma precisar de poucas
+  // buscas em largura em grafos não direcionados
+  if (!ponderadoArestas && !direcionado)
+    return distancia_bfs_exata();
+  // Johnson (ou uma busca em largura por origem, sem pesos) custa
+  // O(V·E·log V) e o Floyd–Warshall O(V³), então é preferido quando o grafo
+  // é esparso (E bem menor que V²)
+  double entradas = (double)get_num_arestas() * (direcionado ? 1 : 2);
+  double log2n = 1;
+  for (int k = n; k > 1; k /= 2)
+    log2n++;
+  if (entradas * log2n * 4 < (double)n * n)
+    return (ponderadoArestas ? distancia_johnson() : distancia_bfs_exata());
+  return distancia_floyd_warshall(true);
+}
 
-  // Aloca uma matriz de distâncias (usando índices 0-based internamente)
-  double **dist = new double *[n];
+MatrizDistancias *Grafo::calcula_matriz_distancias(bool blocado) const {
+  INSTRUMENTA(OP_FLOYD_WARSHALL);
+  int n = get_ordem();
+
+  // Matriz de distâncias contígua (índices 0-based internamente), com INF
+  // onde não há aresta; é preenchida percorrendo os vizinhos de cada nó
+  MatrizDistancias *matriz = new MatrizDistancias(n, INF);
+  REGISTRA_BYTES((long long)matriz->passo * matriz->passo * sizeof(double));
+  MatrizDistancias &dist = *matriz;
   for (int i = 0; i < n; i++) {
-    dist[i] = new double[n];
-  }
-
-  // Inicializa a matriz de distâncias
-  // Usando os métodos virtuais
-  for (int i = 1; i <= n; i++) {
-    for (int j = 1; j <= n; j++) {
-      if (i == j) {
-        dist[i - 1][j - 1] = 0;
-      } else {
-        double peso =
-            getPesoAresta(i, j); // deve retornar INF se não houver aresta
-        dist[i - 1][j - 1] = peso;
-      }
-    }
+    double *linha = dist.linha(i);
+    para_cada_vizinho(i + 1, [linha, n](int destino, int peso) {
+      // A GrafoLista aceita arestas para ids inexistentes em grafos
+      // direcionados; elas não fazem parte da matriz
+      if (destino >= 1 && destino <= n)
+        linha[destino - 1] = peso;
+      return true;
+    });
   }
 
   // Aplica o algoritmo de Floyd–Warshall
-  for (int k = 0; k < n; k++) {
-    for (int i = 0; i < n; i++) {
-      for (int j = 0; j < n; j++) {
-        if (dist[i][k] + dist[k][j] < dist[i][j])
-          dist[i][j] = dist[i][k] + dist[k][j];
-      }
+  if (blocado)
+    floyd_warshall_blocado(dist, PoolThreads::global());
+  else
+    floyd_warshall_escalar(dist);
+  return matriz;
+}
+
+Grafo::ResultadoDistancia Grafo::distancia_floyd_warshall(bool blocado) const {
+  int n = get_ordem();
+  MatrizDistancias *matriz = calcula_matriz_distancias(blocado);
+  const MatrizDistancias &dist = *matriz;
+
+  // Um ciclo negativo aparece como distância negativa de um nó a ele mesmo
+  for (int i = 0; i < n; i++) {
+    if (dist.linha(i)[i] < 0) {
+      delete matriz;
+      ResultadoDistancia res = {-1, -1, -1, true};
+      return res;
     }
   }
 
@@ -180,24 +354,35 @@ Grafo::ResultadoDistancia Grafo::calculaMaiorMenorDistancia() const {
   double maxDist = -1e9;
   int bestI = -1, bestJ = -1;
   for (int i = 0; i < n; i++) {
+    const double *linha = dist.linha(i);
     for (int j = 0; j < n; j++) {
-      if (i != j && dist[i][j] < INF && dist[i][j] > maxDist) {
-        maxDist = dist[i][j];
+      if (i != j && linha[j] < LIMITE_INF && linha[j] > maxDist) {
+        maxDist = linha[j];
         bestI = i;
         bestJ = j;
       }
     }
   }
-
-  // Libera a memória alocada para a matriz de distâncias
-  for (int i = 0; i < n; i++) {
-    delete[] dist[i];
-  }
-  delete[] dist;
+  delete matriz;
 
   ResultadoDistancia res;
   res.no1 = (bestI != -1 ? bestI + 1 : -1);
   res.no2 = (bestJ != -1 ? bestJ + 1 : -1);
   res.distancia = maxDist;
+  res.cicloNegativo = false;
+  return res;
+}
+
+// Resultado a partir da matriz mantida, calculada (Floyd–Warshall blocado)
+// só se ainda não existir ou não corresponder à ordem atual
+Grafo::ResultadoDistancia Grafo::distancia_mantida() const {
+  if (!distancias.valida() || distancias.ordem() != ordem)
+    distancias.inicia(calcula_matriz_distancias(true));
+  if (distancias.ciclo_negativo()) {
+    ResultadoDistancia res = {-1, -1, -1, true};
+    return res;
+  }
+  ResultadoDistancia res = {-1, -1, -1e9, false};
+  distancias.maior_distancia(res.no1, res.no2, res.distancia);
   return res;
 }
@@ -0,0 +1,358 @@
+#include "../include/GrafoAdaptativo.hpp"
+#include "../include/GrafoLista.hpp"
+#include "../include/GrafoMatriz.hpp"
+#include <cmath>
+#include <iostream>
+using namespace std;
+
+// Peso devolvido por getPesoAresta quando a aresta não existe
+static const double AUSENTE = 1e9;
+
+GrafoAdaptativo::GrafoAdaptativo()
+    : interno(new GrafoLista()), representacao(LISTA), vazio(true),
+      carregando(false), nArestas(0), nPesoZero(0), limiarMatriz(0.25),
+      limiarLista(0.0625), migracoes(0) {}
+
+GrafoAdaptativo::~GrafoAdaptativo() { delete interno; }
+
+Grafo *GrafoAdaptativo::cria(Representacao r) {
+  if (r == MATRIZ)
+    return new GrafoMatriz();
+  return new GrafoLista();
+}
+
+bool GrafoAdaptativo::set_limiares(double paraMatriz, double paraLista) {
+  if (!(paraLista >= 0 && paraLista < paraMatriz && paraMatriz <= 1))
+    return false;
+  limiarMatriz = paraMatriz;
+  limiarLista = paraLista;
+  return true;
+}
+
+double GrafoAdaptativo::densidade() const {
+  if (ordem < 2)
+    return 0;
+  double entradas = (double)(direcionado ? nArestas : 2 * nArestas);
+  return entradas / ((double)ordem * ordem);
+}
+
+bool GrafoAdaptativo::existe_aresta(int origem, int destino) const {
+  return interno->getPesoAresta(origem, destino) < AUSENTE;
+}
+
+long long GrafoAdaptativo::conta_peso_zero() const {
+  long long total = 0;
+  int n = interno->get_ordem();
+  for (int v = 1; v <= n; v++) {
+    interno->para_cada_vizinho(v, [&](int w, int peso) {
+      if (peso == 0 && (direcionado || w < v))
+        total++;
+      return true;
+    });
+  }
+  return total;
+}
+
+void GrafoAdaptativo::prepara_peso_zero() {
+  if (representacao == MATRIZ) {
+    migra(LISTA);
+    migracoes++;
+  }
+}
+
+// Os vértices são copiados na ordem dos ids e as arestas em um único lote.
+// O lote percorre os nós e os vizinhos em ordem decrescente: como a
+// GrafoLista insere no início das listas, cada lista termina em ordem
+// crescente, como as linhas da matriz (em grafos não direcionados, a aresta
+// {u, v} entra no lote pelo maior extremo).
+void GrafoAdaptativo::migra(Representacao r) {
+  INSTRUMENTA(OP_MIGRA_REPRESENTACAO);
+  int n = ordem;
+  Grafo *novo = cria(r);
+  copia_propriedades(*novo, *this);
+  novo->reserva(n, (int)nArestas);
+  for (int v = 1; v <= n; v++)
+    novo->inserir_vertice(v, interno->get_peso_vertice(v));
+
+  // Arestas para ids fora do grafo (aceitas pela GrafoLista em grafos
+  // direcionados) não são copiadas
+  long long total = 0;
+  for (int v = 1; v <= n; v++) {
+    interno->para_cada_vizinho(v, [&](int w, int) {
+      if (w >= 1 && w <= n && (direcionado || w < v))
+        total++;
+      return true;
+    });
+  }
+  int *origens = new int[total > 0 ? total : 1];
+  int *destinos = new int[total > 0 ? total : 1];
+  int *pesos = new int[total > 0 ? total : 1];
+  int k = 0;
+  for (int v = n; v >= 1; v--) {
+    int inicio = k;
+    interno->para_cada_vizinho(v, [&](int w, int peso) {
+      if (w >= 1 && w <= n && (direcionado || w < v)) {
+        origens[k] = v;
+        destinos[k] = w;
+        pesos[k++] = peso;
+      }
+      return true;
+    });
+    // Inverte os vizinhos de v (vindos em ordem crescente da matriz)
+    for (int i = inicio, j = k - 1; i < j; i++, j--) {
+      int t = destinos[i];
+      destinos[i] = destinos[j];
+      destinos[j] = t;
+      t = pesos[i];
+      pesos[i] = pesos[j];
+      pesos[j] = t;
+    }
+  }
+  novo->inserir_arestas_lote(origens, destinos, pesos, k);
+  delete[] origens;
+  delete[] destinos;
+  delete[] pesos;
+
+  delete interno;
+  interno = novo;
+  representacao = r;
+  long long antes = nArestas;
+  nArestas = interno->get_num_arestas();
+  // Arestas descartadas (destinos inexistentes)
+  if (nArestas != antes)
+    registra_remocao();
+}
+
+// Durante a carga a densidade parte de zero e só cresce, então só a
+// migração para a matriz é feita antes de fim_carga. Arestas de peso 0
+// mantêm o grafo na lista.
+void GrafoAdaptativo::reavalia() {
+  double d = densidade();
+  if (representacao == LISTA && nPesoZero == 0 && d >= limiarMatriz) {
+    migra(MATRIZ);
+    migracoes++;
+  } else if (representacao == MATRIZ && !carregando && d < limiarLista) {
+    migra(LISTA);
+    migracoes++;
+  }
+}
+
+void GrafoAdaptativo::inserir_vertice(int id, int peso) {
+  INSTRUMENTA(OP_INSERIR_VERTICE);
+  interno->inserir_vertice(id, peso);
+  vazio = false;
+  registra_vertice();
+}
+
+void GrafoAdaptativo::inserir_aresta(int origem, int destino, int peso) {
+  INSTRUMENTA(OP_INSERIR_ARESTA);
+  bool existia = existe_aresta(origem, destino);
+  if (peso == 0 && !existia)
+    prepara_peso_zero();
+  sincroniza_recusas(*this, *interno);
+  interno->inserir_aresta(origem, destino, peso);
+  sincroniza_recusas(*this, *interno);
+  if (!existia && existe_aresta(origem, destino)) {
+    nArestas++;
+    if (peso == 0)
+      nPesoZero++;
+    registra_aresta(origem, destino, peso);
+    reavalia();
+  }
+}
+
+// As arestas presentes após o lote são registradas de novo (registrar uma
+// aresta que já existia não tem efeito). Um lote com pesos 0 leva o grafo
+// para a lista antes da inserção, e as arestas de peso 0 são recontadas.
+void GrafoAdaptativo::inserir_arestas_lote(const int *origens,
+                                           const int *destinos,
+                                           const int *pesos, int n) {
+  INSTRUMENTA(OP_INSERIR_ARESTAS_LOTE);
+  bool pesoZero = false;
+  for (int i = 0; i < n && !pesoZero; i++)
+    pesoZero = (pesos[i] == 0);
+  if (pesoZero)
+    prepara_peso_zero();
+  sincroniza_recusas(*this, *interno);
+  interno->inserir_arestas_lote(origens, destinos, pesos, n);
+  sincroniza_recusas(*this, *interno);
+  for (int i = 0; i < n; i++) {
+    double peso = interno->getPesoAresta(origens[i], destinos[i]);
+    if (peso < AUSENTE)
+      registra_aresta(origens[i], destinos[i], (int)peso);
+  }
+  nArestas = interno->get_num_arestas();
+  if (pesoZero)
+    nPesoZero = conta_peso_zero();
+  reavalia();
+}
+
+// A estimativa usa o limite de arestas do cabeçalho; fim_carga confirma a
+// escolha com o número real
+void GrafoAdaptativo::reserva(int nVertices, int nArestasMax) {
+  if (vazio) {
+    long long antes = nArestas;
+    nArestas = nArestasMax;
+    Representacao r = (densidade() >= sqrt(limiarMatriz * limiarLista)
+                           ? MATRIZ
+                           : LISTA);
+    nArestas = antes;
+    delete interno;
+    interno = cria(r);
+    representacao = r;
+    copia_propriedades(*interno, *this);
+  }
+  carregando = true;
+  interno->reserva(nVertices, nArestasMax);
+}
+
+void GrafoAdaptativo::fim_carga() {
+  carregando = false;
+  sincroniza_recusas(*this, *interno);
+  interno->fim_carga();
+  sincroniza_recusas(*this, *interno);
+  nArestas = interno->get_num_arestas();
+  Representacao r = (nPesoZero == 0 &&
+                             densidade() >= sqrt(limiarMatriz * limiarLista)
+                         ? MATRIZ
+                         : LISTA);
+  if (r != representacao)
+    migra(r);
+}
+
+void GrafoAdaptativo::percorre_vizinhos(int vertice,
+                                        VisitanteVizinhos &visitante) const {
+  interno->percorre_vizinhos(vertice, visitante);
+}
+
+int GrafoAdaptativo::get_grau_saida(int vertice) const {
+  return interno->get_grau_saida(vertice);
+}
+
+int GrafoAdaptativo::get_num_arestas() const {
+  return interno->get_num_arestas();
+}
+
+int GrafoAdaptativo::get_grau_entrada(int vertice) const {
+  return interno->get_grau_entrada(vertice);
+}
+
+void GrafoAdaptativo::percorre_predecessores(
+    int vertice, VisitanteVizinhos &visitante) const {
+  interno->percorre_predecessores(vertice, visitante);
+}
+
+int GrafoAdaptativo::get_peso_vertice(int vertice) const {
+  return interno->get_peso_vertice(vertice);
+}
+
+double GrafoAdaptativo::getPesoAresta(int origem, int destino) const {
+  CONTA_CHAMADA(OP_GET_PESO_ARESTA);
+  return interno->getPesoAresta(origem, destino);
+}
+
+int GrafoAdaptativo::busca_largura(int origem, int *dist, int *fila,
+                                   bool reverso) const {
+  return interno->busca_largura(origem, dist, fila, reverso);
+}
+
+void GrafoAdaptativo::novo_no(int peso) {
+  INSTRUMENTA(OP_NOVO_NO);
+  interno->novo_no(peso);
+  ordem = interno->get_ordem();
+  vazio = false;
+  registra_vertice();
+  reavalia();
+}
+
+void GrafoAdaptativo::nova_aresta(int origem, int destino, int peso) {
+  INSTRUMENTA(OP_NOVA_ARESTA);
+  bool existia = existe_aresta(origem, destino);
+  if (peso == 0 && !existia)
+    prepara_peso_zero();
+  interno->nova_aresta(origem, destino, peso);
+  if (!existia && existe_aresta(origem, destino)) {
+    nArestas++;
+    if (peso == 0)
+      nPesoZero++;
+    registra_aresta(origem, destino, peso);
+    reavalia();
+  }
+}
+
+void GrafoAdaptativo::altera_peso_aresta(int origem, int destino, int peso) {
+  INSTRUMENTA(OP_ALTERA_PESO_ARESTA);
+  double antigo = interno->getPesoAresta(origem, destino);
+  if (antigo >= AUSENTE || peso == antigo)
+    return;
+  // Na matriz, peso 0 removeria a aresta
+  if (peso == 0)
+    prepara_peso_zero();
+  interno->altera_peso_aresta(origem, destino, peso);
+  if (antigo == 0)
+    nPesoZero--;
+  if (peso == 0)
+    nPesoZero++;
+  registra_peso(origem, destino, (int)antigo, peso);
+  reavalia();
+}
+
+void GrafoAdaptativo::deleta_no(int id) {
+  INSTRUMENTA(OP_DELETA_NO);
+  interno->deleta_no(id);
+  if (interno->get_ordem() == ordem)
+    return;
+  ordem = interno->get_ordem();
+  nArestas = interno->get_num_arestas();
+  if (nPesoZero > 0)
+    nPesoZero = conta_peso_zero();
+  registra_remocao();
+  reavalia();
+}
+
+void GrafoAdaptativo::deleta_aresta(int origem, int destino) {
+  INSTRUMENTA(OP_DELETA_ARESTA);
+  double peso = interno->getPesoAresta(origem, destino);
+  interno->deleta_aresta(origem, destino);
+  if (peso < AUSENTE && !existe_aresta(origem, destino)) {
+    nArestas--;
+    if (peso == 0)
+      nPesoZero--;
+    registra_remocao();
+    reavalia();
+  }
+}
+
+void GrafoAdaptativo::deleta_nos(const int *ids, int k) {
+  INSTRUMENTA(OP_DELETA_NOS);
+  interno->deleta_nos(ids, k);
+  if (interno->get_ordem() == ordem)
+    return;
+  ordem = interno->get_ordem();
+  nArestas = interno->get_num_arestas();
+  if (nPesoZero > 0)
+    nPesoZero = conta_peso_zero();
+  registra_remocao();
+  reavalia();
+}
+
+void GrafoAdaptativo::deleta_arestas(const int *origens, const int *destinos,
+                                     int n) {
+  INSTRUMENTA(OP_DELETA_ARESTAS);
+  interno->deleta_arestas(origens, destinos, n);
+  long long antes = nArestas;
+  nArestas = interno->get_num_arestas();
+  if (nArestas == antes)
+    return;
+  if (nPesoZero > 0)
+    nPesoZero = conta_peso_zero();
+  registra_remocao();
+  reavalia();
+}
+
+void GrafoAdaptativo::imprime_grafo() const {
+  std::cout << "Grafo adaptativo (representação atual: "
+            << (representacao == MATRIZ ? "matriz" : "lista") << ")"
+            << std::endl;
+  interno->imprime_grafo();
+}
@@ -0,0 +1,419 @@
+#include "../include/GrafoBitMatriz.hpp"
+#include "../include/IntList.hpp"
+#include <cstdlib>
+#include <iostream>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+using namespace std;
+
+const double INF = 1e9;
+
+static inline int conta_bits(uint64_t x) {
+#if defined(_MSC_VER)
+  return (int)__popcnt64(x);
+#else
+  return __builtin_popcountll(x);
+#endif
+}
+
+// Índice do bit ligado menos significativo (x != 0)
+static inline int primeiro_bit(uint64_t x) {
+#if defined(_MSC_VER)
+  unsigned long i;
+  _BitScanForward64(&i, x);
+  return (int)i;
+#else
+  return __builtin_ctzll(x);
+#endif
+}
+
+static int conta_linha(const uint64_t *linha, int nPalavras) {
+  int total = 0;
+  for (int k = 0; k < nPalavras; k++)
+    total += conta_bits(linha[k]);
+  return total;
+}
+
+// Copia uma linha de 'orig' para 'dest' (que pode ser a mesma) removendo o
+// bit 'pos' e deslocando os bits seguintes uma posição para baixo
+static void remove_bit(const uint64_t *orig, uint64_t *dest, int nPalavras,
+                       int pos) {
+  int p = pos >> 6;
+  uint64_t abaixo = (1ULL << (pos & 63)) - 1; // bits anteriores a pos
+  for (int k = 0; k < p; k++)
+    dest[k] = orig[k];
+  for (int k = p; k < nPalavras; k++) {
+    uint64_t prox = (k + 1 < nPalavras ? orig[k + 1] : 0);
+    uint64_t deslocado = (orig[k] >> 1) | (prox << 63);
+    dest[k] = (k == p ? (orig[k] & abaixo) | (deslocado & ~abaixo)
+                      : deslocado);
+  }
+}
+
+// Copia uma linha de 'orig' para 'dest' (distintas) levando o bit j para
+// novoId[j], ou descartando-o se novoId[j] < 0. Como novoId é crescente nos
+// nós mantidos, cada bit vai para uma posição menor ou igual.
+static void remapeia_bits(const uint64_t *orig, uint64_t *dest, int nPalavras,
+                          const int *novoId) {
+  for (int k = 0; k < nPalavras; k++)
+    dest[k] = 0;
+  for (int k = 0; k < nPalavras; k++) {
+    uint64_t w = orig[k];
+    while (w != 0) {
+      int j = novoId[(k << 6) + primeiro_bit(w)];
+      if (j >= 0)
+        dest[j >> 6] |= 1ULL << (j & 63);
+      w &= w - 1;
+    }
+  }
+}
+
+// Percorre os bits ligados de uma linha, em ordem crescente de coluna
+static void percorre_bits(const uint64_t *linha, int nPalavras,
+                          VisitanteVizinhos &visitante) {
+  for (int k = 0; k < nPalavras; k++) {
+    uint64_t w = linha[k];
+    while (w != 0) {
+      int j = (k << 6) + primeiro_bit(w);
+      if (!visitante.visita(j + 1, 1))
+        return;
+      w &= w - 1;
+    }
+  }
+}
+
+GrafoBitMatriz::GrafoBitMatriz()
+    : linhas(nullptr), colunas(nullptr), pesosVertices(nullptr),
+      capacidade(64), palavras(1), nNos(0) {
+  linhas = new uint64_t[(size_t)capacidade * palavras]();
+  pesosVertices = new int[capacidade];
+}
+
+GrafoBitMatriz::~GrafoBitMatriz() {
+  delete[] linhas;
+  delete[] colunas;
+  delete[] pesosVertices;
+}
+
+void GrafoBitMatriz::realocarMatriz(int novaCapacidade) {
+  INSTRUMENTA(OP_REALOCAR_MATRIZ);
+  int novasPalavras = novaCapacidade / 64;
+  uint64_t *novasLinhas = new uint64_t[(size_t)novaCapacidade * novasPalavras]();
+  uint64_t *novasColunas = nullptr;
+  if (direcionado)
+    novasColunas = new uint64_t[(size_t)novaCapacidade * novasPalavras]();
+  for (int i = 0; i < nNos; i++) {
+    for (int k = 0; k < palavras; k++) {
+      novasLinhas[(size_t)i * novasPalavras + k] = linha(i)[k];
+      if (direcionado)
+        novasColunas[(size_t)i * novasPalavras + k] = coluna(i)[k];
+    }
+  }
+  int *novoPesos = new int[novaCapacidade];
+  for (int i = 0; i < nNos; i++)
+    novoPesos[i] = pesosVertices[i];
+  REGISTRA_BYTES((long long)novaCapacidade * novasPalavras * sizeof(uint64_t) *
+                     (direcionado ? 2 : 1) +
+                 (long long)novaCapacidade * sizeof(int));
+
+  delete[] linhas;
+  delete[] colunas;
+  delete[] pesosVertices;
+  linhas = novasLinhas;
+  colunas = novasColunas;
+  pesosVertices = novoPesos;
+  capacidade = novaCapacidade;
+  palavras = novasPalavras;
+}
+
+void GrafoBitMatriz::define_bit(int o, int d, bool valor) {
+  uint64_t bitD = 1ULL << (d & 63);
+  uint64_t bitO = 1ULL << (o & 63);
+  if (valor) {
+    linha(o)[d >> 6] |= bitD;
+    if (direcionado)
+      coluna(d)[o >> 6] |= bitO;
+  } else {
+    linha(o)[d >> 6] &= ~bitD;
+    if (direcionado)
+      coluna(d)[o >> 6] &= ~bitO;
+  }
+}
+
+void GrafoBitMatriz::inserir_vertice(int id, int peso) {
+  INSTRUMENTA(OP_INSERIR_VERTICE);
+  (void)id;
+  // A transposta só é necessária em grafos direcionados, o que só se sabe
+  // depois de lido o cabeçalho
+  if (direcionado && colunas == nullptr)
+    colunas = new uint64_t[(size_t)capacidade * palavras]();
+  if (nNos >= capacidade)
+    realocarMatriz(capacidade * 2);
+  pesosVertices[nNos] = peso;
+  nNos++;
+  registra_vertice();
+}
+
+void GrafoBitMatriz::inserir_aresta(int origem, int destino, int peso) {
+  INSTRUMENTA(OP_INSERIR_ARESTA);
+  int o = origem - 1;
+  int d = destino - 1;
+  if (origem == destino) {
+    if (reporta_recusa())
+      cerr << "Erro: laço não permitido (origem == destino).\n";
+    return;
+  }
+  if (o < 0 || o >= nNos || d < 0 || d >= nNos) {
+    if (reporta_recusa())
+      cerr << "Indices de aresta invalidos." << endl;
+    return;
+  }
+  if (tem_bit(o, d)) {
+    if (reporta_recusa())
+      cerr << "Erro: aresta já existe (aresta múltipla não permitida).\n";
+    return;
+  }
+  // Como na GrafoMatriz, peso 0 representa ausência de aresta
+  if (peso == 0)
+    return;
+  define_bit(o, d, true);
+  if (!direcionado)
+    define_bit(d, o, true);
+  registra_aresta(origem, destino, 1);
+}
+
+void GrafoBitMatriz::reserva(int nVertices, int nArestas) {
+  (void)nArestas;
+  if (nVertices > capacidade)
+    realocarMatriz((nVertices + 63) / 64 * 64);
+}
+
+void GrafoBitMatriz::fim_carga() {
+  if (ponderadoArestas)
+    cerr << "Aviso: GrafoBitMatriz não armazena pesos de arestas; todas as "
+            "arestas são tratadas com peso 1.\n";
+}
+
+void GrafoBitMatriz::percorre_vizinhos(int vertice,
+                                       VisitanteVizinhos &visitante) const {
+  int idx = vertice - 1;
+  if (idx < 0 || idx >= nNos)
+    return;
+  percorre_bits(linha(idx), palavras_usadas(), visitante);
+}
+
+int GrafoBitMatriz::get_grau_saida(int vertice) const {
+  int idx = vertice - 1;
+  if (idx < 0 || idx >= nNos)
+    return 0;
+  return conta_linha(linha(idx), palavras_usadas());
+}
+
+int GrafoBitMatriz::get_num_arestas() const {
+  int total = 0;
+  for (int i = 0; i < nNos; i++)
+    total += conta_linha(linha(i), palavras_usadas());
+  return (direcionado ? total : total / 2);
+}
+
+int GrafoBitMatriz::get_grau_entrada(int vertice) const {
+  int idx = vertice - 1;
+  if (idx < 0 || idx >= nNos)
+    return 0;
+  return conta_linha(direcionado ? coluna(idx) : linha(idx),
+                     palavras_usadas());
+}
+
+void GrafoBitMatriz::percorre_predecessores(
+    int vertice, VisitanteVizinhos &visitante) const {
+  int idx = vertice - 1;
+  if (idx < 0 || idx >= nNos)
+    return;
+  percorre_bits(direcionado ? coluna(idx) : linha(idx), palavras_usadas(),
+                visitante);
+}
+
+int GrafoBitMatriz::get_peso_vertice(int vertice) const {
+  int idx = vertice - 1;
+  if (idx < 0 || idx >= nNos)
+    return 0;
+  return pesosVertices[idx];
+}
+
+double GrafoBitMatriz::getPesoAresta(int origem, int destino) const {
+  CONTA_CHAMADA(OP_GET_PESO_ARESTA);
+  int o = origem - 1;
+  int d = destino - 1;
+  if (o < 0 || o >= nNos || d < 0 || d >= nNos)
+    return INF;
+  return (tem_bit(o, d) ? 1.0 : INF);
+}
+
+// Busca em largura nível a nível: a próxima fronteira é o OU das linhas dos
+// nós da fronteira atual, sem os já visitados. Os nós de cada nível entram
+// na fila em ordem crescente de id.
+int GrafoBitMatriz::busca_largura(int origem, int *dist, int *fila,
+                                  bool reverso) const {
+  int nPalavras = palavras_usadas();
+  const bool usaColunas = (reverso && direcionado);
+  uint64_t *visitado = new uint64_t[nPalavras]();
+  uint64_t *proxima = new uint64_t[nPalavras];
+  int s = origem - 1;
+  visitado[s >> 6] |= 1ULL << (s & 63);
+  dist[origem] = 0;
+  fila[0] = origem;
+  int ini = 0, fim = 1;
+  for (int nivel = 1; ini < fim; nivel++) {
+    for (int k = 0; k < nPalavras; k++)
+      proxima[k] = 0;
+    for (int i = ini; i < fim; i++) {
+      const uint64_t *l = (usaColunas ? coluna(fila[i] - 1) : linha(fila[i] - 1));
+      for (int k = 0; k < nPalavras; k++)
+        proxima[k] |= l[k];
+    }
+    ini = fim;
+    for (int k = 0; k < nPalavras; k++) {
+      uint64_t novos = proxima[k] & ~visitado[k];
+      visitado[k] |= novos;
+      while (novos != 0) {
+        int v = (k << 6) + primeiro_bit(novos) + 1;
+        dist[v] = nivel;
+        fila[fim++] = v;
+        novos &= novos - 1;
+      }
+    }
+  }
+  delete[] visitado;
+  delete[] proxima;
+  return fim;
+}
+
+void GrafoBitMatriz::novo_no(int peso) {
+  INSTRUMENTA(OP_NOVO_NO);
+  inserir_vertice(nNos + 1, peso);
+  ordem++;
+}
+
+void GrafoBitMatriz::nova_aresta(int origem, int destino, int peso) {
+  INSTRUMENTA(OP_NOVA_ARESTA);
+  inserir_aresta(origem, destino, peso);
+}
+
+void GrafoBitMatriz::altera_peso_aresta(int origem, int destino, int peso) {
+  INSTRUMENTA(OP_ALTERA_PESO_ARESTA);
+  (void)origem;
+  (void)destino;
+  (void)peso;
+  cerr << "Erro: GrafoBitMatriz não armazena pesos de arestas." << endl;
+}
+
+void GrafoBitMatriz::deleta_no(int id) {
+  INSTRUMENTA(OP_DELETA_NO);
+  int index = id - 1;
+  if (index < 0 || index >= nNos) {
+    cerr << "Erro: Vértice " << id << " não existe." << endl;
+    return;
+  }
+  registra_remocao();
+
+  // Remove a linha do nó (as linhas seguintes sobem uma posição) e o bit da
+  // sua coluna em todas as linhas remanescentes
+  for (int i = 0; i < nNos; i++) {
+    if (i == index)
+      continue;
+    int novo = (i < index ? i : i - 1);
+    remove_bit(linha(i), linha(novo), palavras, index);
+    if (direcionado)
+      remove_bit(coluna(i), coluna(novo), palavras, index);
+  }
+  for (int k = 0; k < palavras; k++) {
+    linha(nNos - 1)[k] = 0;
+    if (direcionado)
+      coluna(nNos - 1)[k] = 0;
+  }
+  for (int v = index; v < nNos - 1; v++)
+    pesosVertices[v] = pesosVertices[v + 1];
+
+  nNos--;
+  ordem = nNos;
+}
+
+// Todas as remoções em uma passada: cada linha mantida é remapeada uma vez e
+// vai para a sua nova posição (nunca maior que a atual)
+void GrafoBitMatriz::deleta_nos(const int *ids, int k) {
+  INSTRUMENTA(OP_DELETA_NOS);
+  bool *removido = new bool[nNos > 0 ? nNos : 1];
+  int nRemovidos = marca_remocoes(ids, k, nNos, removido);
+  if (nRemovidos == 0) {
+    delete[] removido;
+    return;
+  }
+  registra_remocao();
+  int *novoId = new int[nNos];
+  int vivos = 0;
+  for (int i = 0; i < nNos; i++)
+    novoId[i] = (removido[i] ? -1 : vivos++);
+
+  uint64_t *temp = new uint64_t[palavras];
+  for (int i = 0; i < nNos; i++) {
+    if (removido[i])
+      continue;
+    remapeia_bits(linha(i), temp, palavras, novoId);
+    for (int w = 0; w < palavras; w++)
+      linha(novoId[i])[w] = temp[w];
+    if (direcionado) {
+      remapeia_bits(coluna(i), temp, palavras, novoId);
+      for (int w = 0; w < palavras; w++)
+        coluna(novoId[i])[w] = temp[w];
+    }
+    pesosVertices[novoId[i]] = pesosVertices[i];
+  }
+  for (int i = vivos; i < nNos; i++) {
+    for (int w = 0; w < palavras; w++) {
+      linha(i)[w] = 0;
+      if (direcionado)
+        coluna(i)[w] = 0;
+    }
+  }
+  delete[] temp;
+  delete[] novoId;
+  delete[] removido;
+  nNos = vivos;
+  ordem = nNos;
+}
+
+void GrafoBitMatriz::deleta_aresta(int origem, int destino) {
+  INSTRUMENTA(OP_DELETA_ARESTA);
+  int o = origem - 1;
+  int d = destino - 1;
+  if (o < 0 || o >= nNos || d < 0 || d >= nNos) {
+    cerr << "Indices de aresta invalidos." << endl;
+    return;
+  }
+  registra_remocao();
+  define_bit(o, d, false);
+  if (!direcionado)
+    define_bit(d, o, false);
+}
+
+void GrafoBitMatriz::imprime_grafo() const {
+  std::cout << "Grafo (Matriz de Bits):" << std::endl;
+  std::cout << "Ordem: " << ordem << std::endl;
+  for (int i = 0; i < nNos; i++) {
+    std::cout << "Vértice " << (i + 1);
+    if (ponderadoVertices)
+      std::cout << " (peso: " << pesosVertices[i] << ")";
+    std::cout << " -> ";
+    bool temVizinhos = false;
+    for (int j = 0; j < nNos; j++) {
+      if (tem_bit(i, j)) {
+        std::cout << (j + 1) << " ";
+        temVizinhos = true;
+      }
+    }
+    if (!temVizinhos)
+      std::cout << "Sem vizinhos";
+    std::cout << std::endl;
+  }
+}
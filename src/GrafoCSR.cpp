@@ -0,0 +1,760 @@
+#include "../include/GrafoCSR.hpp"
+#include "../include/FormatoBinario.hpp"
+#include "../include/IntList.hpp"
+#include <cstdlib>
+#include <iostream>
+using namespace std;
+
+const double INF = 1e9;
+
+GrafoCSR::GrafoCSR()
+    : nNos(0), nLinhas(0), nEntradas(0), offsets(nullptr), destinos(nullptr),
+      pesos(nullptr), pesosVertices(nullptr), roffsets(nullptr),
+      rorigens(nullptr), rpesos(nullptr), capVertices(10),
+      construido(false), mapa(nullptr), pendOrigem(nullptr), pendDestino(nullptr),
+      pendPeso(nullptr), nPendentes(0), capPendentes(0) {
+  pesosVertices = new int[capVertices];
+  offsets = new int[1];
+  offsets[0] = 0;
+}
+
+GrafoCSR::GrafoCSR(const Grafo &origem) : GrafoCSR() {
+  ordem = origem.get_ordem();
+  direcionado = origem.eh_direcionado();
+  ponderadoVertices = origem.vertice_ponderado();
+  ponderadoArestas = origem.aresta_ponderada();
+
+  for (int v = 1; v <= ordem; v++)
+    inserir_vertice(v, origem.get_peso_vertice(v));
+  for (int v = 1; v <= ordem; v++) {
+    origem.para_cada_vizinho(v, [this, v](int w, int peso) {
+      // A GrafoLista direcionada pode guardar destinos inexistentes, que o
+      // CSR não representa
+      if (w < 1 || w > ordem)
+        return true;
+      // Em grafos não direcionados cada aresta aparece nas duas linhas; a
+      // reconstrução recria a entrada simétrica
+      if (direcionado || w > v) {
+        adiciona_pendente(v, w, peso);
+        registra_aresta(v, w, peso);
+      }
+      return true;
+    });
+  }
+  fim_carga();
+}
+
+GrafoCSR::~GrafoCSR() {
+  libera_vetores();
+  delete[] pendOrigem;
+  delete[] pendDestino;
+  delete[] pendPeso;
+}
+
+void GrafoCSR::libera_vetores() {
+  if (mapa == nullptr) {
+    delete[] offsets;
+    delete[] destinos;
+    delete[] pesos;
+    delete[] pesosVertices;
+    delete[] roffsets;
+    delete[] rorigens;
+    delete[] rpesos;
+  }
+  delete mapa;
+  mapa = nullptr;
+  offsets = destinos = pesos = pesosVertices = nullptr;
+  roffsets = rorigens = rpesos = nullptr;
+}
+
+static int *copia_vetor(const int *origem, int n, int capacidade) {
+  int *copia = new int[capacidade];
+  for (int i = 0; i < n; i++)
+    copia[i] = origem[i];
+  return copia;
+}
+
+void GrafoCSR::desvincula_mapa() {
+  if (mapa == nullptr)
+    return;
+  capVertices = (nNos > 10 ? nNos : 10);
+  pesosVertices = copia_vetor(pesosVertices, nNos, capVertices);
+  offsets = copia_vetor(offsets, nNos + 1, nNos + 1);
+  destinos = copia_vetor(destinos, nEntradas, nEntradas);
+  pesos = copia_vetor(pesos, nEntradas, nEntradas);
+  if (direcionado) {
+    roffsets = copia_vetor(roffsets, nNos + 1, nNos + 1);
+    rorigens = copia_vetor(rorigens, nEntradas, nEntradas);
+    rpesos = copia_vetor(rpesos, nEntradas, nEntradas);
+  }
+  delete mapa;
+  mapa = nullptr;
+}
+
+// Os vetores passam a apontar para as seções do arquivo mapeado, sem cópia
+// nem reconstrução: o arquivo já está no formato da GrafoCSR
+bool GrafoCSR::carrega_binario(const string &nomeArquivo) {
+  INSTRUMENTA(OP_CARREGA_BINARIO);
+  ArquivoMapeado *arquivo = new ArquivoMapeado();
+  const CabecalhoBinario *cabecalho = abre_binario(*arquivo, nomeArquivo);
+  if (cabecalho == nullptr) {
+    delete arquivo;
+    return false;
+  }
+  libera_vetores();
+  delete[] pendOrigem;
+  delete[] pendDestino;
+  delete[] pendPeso;
+  pendOrigem = pendDestino = pendPeso = nullptr;
+  nPendentes = capPendentes = 0;
+
+  nNos = nLinhas = ordem = cabecalho->ordem;
+  nEntradas = (int)cabecalho->nEntradas;
+  direcionado = (cabecalho->flags & BINARIO_DIRECIONADO) != 0;
+  ponderadoVertices = (cabecalho->flags & BINARIO_PONDERADO_VERTICES) != 0;
+  ponderadoArestas = (cabecalho->flags & BINARIO_PONDERADO_ARESTAS) != 0;
+  LayoutBinario layout(nNos, nEntradas, direcionado);
+  // Os vetores mapeados são somente leitura: toda alteração chama antes
+  // desvincula_mapa
+  char *base = const_cast<char *>(arquivo->inicio());
+  pesosVertices = (int *)(base + layout.pesosVertices);
+  offsets = (int *)(base + layout.offsets);
+  destinos = (int *)(base + layout.destinos);
+  pesos = (int *)(base + layout.pesos);
+  if (direcionado) {
+    roffsets = (int *)(base + layout.roffsets);
+    rorigens = (int *)(base + layout.rorigens);
+    rpesos = (int *)(base + layout.rpesos);
+  }
+  capVertices = nNos;
+  construido = true;
+  mapa = arquivo;
+  // O conteúdo anterior foi substituído: componentes e distâncias são
+  // refeitas na próxima consulta
+  registra_remocao();
+  return true;
+}
+
+void GrafoCSR::reserva_vertices(int novaCapacidade) {
+  int *novoPesos = new int[novaCapacidade];
+  for (int i = 0; i < nNos; i++)
+    novoPesos[i] = pesosVertices[i];
+  delete[] pesosVertices;
+  pesosVertices = novoPesos;
+  capVertices = novaCapacidade;
+}
+
+void GrafoCSR::reserva_pendentes(int novaCapacidade) {
+  int *no = new int[novaCapacidade];
+  int *nd = new int[novaCapacidade];
+  int *np = new int[novaCapacidade];
+  for (int i = 0; i < nPendentes; i++) {
+    no[i] = pendOrigem[i];
+    nd[i] = pendDestino[i];
+    np[i] = pendPeso[i];
+  }
+  delete[] pendOrigem;
+  delete[] pendDestino;
+  delete[] pendPeso;
+  pendOrigem = no;
+  pendDestino = nd;
+  pendPeso = np;
+  capPendentes = novaCapacidade;
+}
+
+void GrafoCSR::reserva(int nVertices, int nArestas) {
+  desvincula_mapa();
+  if (nVertices > capVertices)
+    reserva_vertices(nVertices);
+  if (nPendentes + nArestas > capPendentes)
+    reserva_pendentes(nPendentes + nArestas);
+}
+
+void GrafoCSR::adiciona_pendente(int origem, int destino, int peso) {
+  if (nPendentes == capPendentes)
+    reserva_pendentes(capPendentes == 0 ? 16 : capPendentes * 2);
+  pendOrigem[nPendentes] = origem;
+  pendDestino[nPendentes] = destino;
+  pendPeso[nPendentes] = peso;
+  nPendentes++;
+}
+
+// Ordena (de forma estável) os índices de 'entrada' pela chave informada,
+// usando counting sort com chaves em [0, nChaves)
+static void ordena_por_chave(const int *chave, const int *entrada, int *saida,
+                             int total, int nChaves) {
+  int *cont = new int[nChaves + 1];
+  for (int i = 0; i <= nChaves; i++)
+    cont[i] = 0;
+  for (int i = 0; i < total; i++)
+    cont[chave[entrada[i]] + 1]++;
+  for (int i = 0; i < nChaves; i++)
+    cont[i + 1] += cont[i];
+  for (int i = 0; i < total; i++)
+    saida[cont[chave[entrada[i]]]++] = entrada[i];
+  delete[] cont;
+}
+
+// Junta as entradas atuais com as arestas pendentes e gera novos vetores CSR,
+// ordenados por (origem, destino). Em caso de aresta repetida prevalece a
+// primeira inserida, como nas demais implementações.
+void GrafoCSR::constroi() {
+  int porPendente = (direcionado ? 1 : 2);
+  int total = nEntradas + nPendentes * porPendente;
+
+  int *o = new int[total];
+  int *d = new int[total];
+  int *p = new int[total];
+  int *tag = new int[total]; // -1 para entradas já existentes
+  int k = 0;
+  for (int v = 0; v < nLinhas; v++) {
+    for (int e = offsets[v]; e < offsets[v + 1]; e++) {
+      o[k] = v;
+      d[k] = destinos[e];
+      p[k] = pesos[e];
+      tag[k] = -1;
+      k++;
+    }
+  }
+  for (int i = 0; i < nPendentes; i++) {
+    o[k] = pendOrigem[i] - 1;
+    d[k] = pendDestino[i] - 1;
+    p[k] = pendPeso[i];
+    tag[k] = i;
+    k++;
+    if (!direcionado) {
+      o[k] = pendDestino[i] - 1;
+      d[k] = pendOrigem[i] - 1;
+      p[k] = pendPeso[i];
+      tag[k] = i;
+      k++;
+    }
+  }
+
+  // Ordena por destino e depois por origem (ambos estáveis)
+  int *idx = new int[total];
+  int *aux = new int[total];
+  for (int i = 0; i < total; i++)
+    idx[i] = i;
+  ordena_por_chave(d, idx, aux, total, nNos);
+  ordena_por_chave(o, aux, idx, total, nNos);
+
+  bool *rejeitada = new bool[nPendentes];
+  for (int i = 0; i < nPendentes; i++)
+    rejeitada[i] = false;
+
+  int *novoOffsets = new int[nNos + 1];
+  int *novoDestinos = new int[total];
+  int *novoPesos = new int[total];
+  int n = 0;
+  int linha = 0;
+  novoOffsets[0] = 0;
+  for (int i = 0; i < total; i++) {
+    int e = idx[i];
+    while (linha < o[e]) {
+      novoOffsets[++linha] = n;
+    }
+    if (n > novoOffsets[linha] && novoDestinos[n - 1] == d[e]) {
+      // Aresta repetida: descarta e informa uma única vez por inserção
+      if (tag[e] >= 0 && !rejeitada[tag[e]]) {
+        rejeitada[tag[e]] = true;
+        if (reporta_recusa())
+          cerr << "Erro: Aresta de " << pendOrigem[tag[e]] << " para "
+               << pendDestino[tag[e]] << " já existe." << endl;
+      }
+      continue;
+    }
+    novoDestinos[n] = d[e];
+    novoPesos[n] = p[e];
+    n++;
+  }
+  while (linha < nNos) {
+    novoOffsets[++linha] = n;
+  }
+
+  delete[] o;
+  delete[] d;
+  delete[] p;
+  delete[] tag;
+  delete[] idx;
+  delete[] aux;
+  delete[] rejeitada;
+  delete[] offsets;
+  delete[] destinos;
+  delete[] pesos;
+
+  offsets = novoOffsets;
+  destinos = novoDestinos;
+  pesos = novoPesos;
+  nEntradas = n;
+  nLinhas = nNos;
+  nPendentes = 0;
+  constroi_reverso();
+}
+
+// Gera o CSR reverso a partir do direto. Como as linhas são percorridas em
+// ordem, as origens de cada nó também ficam ordenadas.
+void GrafoCSR::constroi_reverso() {
+  delete[] roffsets;
+  delete[] rorigens;
+  delete[] rpesos;
+  roffsets = rorigens = rpesos = nullptr;
+  if (!direcionado)
+    return;
+
+  roffsets = new int[nNos + 1];
+  rorigens = new int[nEntradas];
+  rpesos = new int[nEntradas];
+  for (int v = 0; v <= nNos; v++)
+    roffsets[v] = 0;
+  for (int e = 0; e < nEntradas; e++)
+    roffsets[destinos[e] + 1]++;
+  for (int v = 0; v < nNos; v++)
+    roffsets[v + 1] += roffsets[v];
+  int *pos = new int[nNos];
+  for (int v = 0; v < nNos; v++)
+    pos[v] = roffsets[v];
+  for (int v = 0; v < nNos; v++) {
+    for (int e = offsets[v]; e < offsets[v + 1]; e++) {
+      int k = pos[destinos[e]]++;
+      rorigens[k] = v;
+      rpesos[k] = pesos[e];
+    }
+  }
+  delete[] pos;
+}
+
+void GrafoCSR::inserir_vertice(int id, int peso) {
+  INSTRUMENTA(OP_INSERIR_VERTICE);
+  (void)id;
+  desvincula_mapa();
+  if (nNos >= capVertices)
+    reserva_vertices(capVertices * 2);
+  pesosVertices[nNos] = peso;
+  nNos++;
+  registra_vertice();
+  if (construido) {
+    // Acrescenta uma linha vazia ao final
+    int *novoOffsets = new int[nNos + 1];
+    for (int i = 0; i < nNos; i++)
+      novoOffsets[i] = offsets[i];
+    novoOffsets[nNos] = nEntradas;
+    delete[] offsets;
+    offsets = novoOffsets;
+    nLinhas = nNos;
+    constroi_reverso();
+  }
+}
+
+void GrafoCSR::inserir_aresta(int origem, int destino, int peso) {
+  INSTRUMENTA(OP_INSERIR_ARESTA);
+  desvincula_mapa();
+  if (origem == destino) {
+    if (reporta_recusa())
+      cerr << "Erro: Laço não permitido (origem e destino iguais: " << origem
+           << ")." << endl;
+    return;
+  }
+  if (origem < 1 || origem > nNos) {
+    if (reporta_recusa())
+      cerr << "Erro: Vértice " << origem << " não encontrado." << endl;
+    return;
+  }
+  if (destino < 1 || destino > nNos) {
+    if (reporta_recusa())
+      cerr << "Erro: Vértice " << destino << " não encontrado." << endl;
+    return;
+  }
+  // Com o grafo construído, a repetida é recusada pela busca binária, sem
+  // reconstruir; durante a carga ela é descartada por constroi
+  if (construido && busca_entrada(origem - 1, destino - 1) >= 0) {
+    if (reporta_recusa())
+      cerr << "Erro: Aresta de " << origem << " para " << destino
+           << " já existe." << endl;
+    return;
+  }
+  adiciona_pendente(origem, destino, peso);
+  // Uma aresta repetida da carga não altera as componentes (e as distâncias
+  // só são mantidas com o grafo construído)
+  registra_aresta(origem, destino, peso);
+  if (construido)
+    constroi();
+}
+
+void GrafoCSR::inserir_arestas_lote(const int *origensLote,
+                                    const int *destinosLote,
+                                    const int *pesosLote, int n) {
+  INSTRUMENTA(OP_INSERIR_ARESTAS_LOTE);
+  if (!construido) {
+    Grafo::inserir_arestas_lote(origensLote, destinosLote, pesosLote, n);
+    return;
+  }
+  desvincula_mapa();
+  for (int i = 0; i < n; i++) {
+    int origem = origensLote[i];
+    int destino = destinosLote[i];
+    if (origem == destino) {
+      if (reporta_recusa())
+        cerr << "Erro: Laço não permitido (origem e destino iguais: "
+             << origem << ")." << endl;
+    } else if (origem < 1 || origem > nNos) {
+      if (reporta_recusa())
+        cerr << "Erro: Vértice " << origem << " não encontrado." << endl;
+    } else if (destino < 1 || destino > nNos) {
+      if (reporta_recusa())
+        cerr << "Erro: Vértice " << destino << " não encontrado." << endl;
+    } else if (busca_entrada(origem - 1, destino - 1) >= 0) {
+      if (reporta_recusa())
+        cerr << "Erro: Aresta de " << origem << " para " << destino
+             << " já existe." << endl;
+    } else {
+      adiciona_pendente(origem, destino, pesosLote[i]);
+    }
+  }
+  int nLote = nPendentes;
+  if (nLote == 0)
+    return;
+  // Repetidas dentro do lote são descartadas por constroi, que mantém a
+  // primeira (como na inserção sucessiva). Os vetores de pendentes não são
+  // liberados por constroi: as aceitas são registradas em seguida (uma
+  // repetida de mesmo peso não altera as componentes nem as distâncias).
+  constroi();
+  for (int i = 0; i < nLote; i++) {
+    int e = busca_entrada(pendOrigem[i] - 1, pendDestino[i] - 1);
+    if (pesos[e] == pendPeso[i])
+      registra_aresta(pendOrigem[i], pendDestino[i], pendPeso[i]);
+  }
+}
+
+void GrafoCSR::fim_carga() {
+  constroi();
+  construido = true;
+  // Libera o espaço usado durante a carga
+  delete[] pendOrigem;
+  delete[] pendDestino;
+  delete[] pendPeso;
+  pendOrigem = pendDestino = pendPeso = nullptr;
+  capPendentes = 0;
+}
+
+int GrafoCSR::busca_entrada(int o, int d) const {
+  int ini = offsets[o];
+  int fim = offsets[o + 1] - 1;
+  while (ini <= fim) {
+    int meio = ini + (fim - ini) / 2;
+    if (destinos[meio] == d)
+      return meio;
+    if (destinos[meio] < d)
+      ini = meio + 1;
+    else
+      fim = meio - 1;
+  }
+  return -1;
+}
+
+void GrafoCSR::percorre_vizinhos(int vertice,
+                                 VisitanteVizinhos &visitante) const {
+  int idx = vertice - 1;
+  if (idx < 0 || idx >= nNos)
+    return;
+  for (int e = offsets[idx]; e < offsets[idx + 1]; e++) {
+    if (!visitante.visita(destinos[e] + 1, pesos[e]))
+      return;
+  }
+}
+
+int GrafoCSR::get_grau_saida(int vertice) const {
+  int idx = vertice - 1;
+  if (idx < 0 || idx >= nNos)
+    return 0;
+  return offsets[idx + 1] - offsets[idx];
+}
+
+int GrafoCSR::get_peso_vertice(int vertice) const {
+  int idx = vertice - 1;
+  if (idx < 0 || idx >= nNos)
+    return 0;
+  return pesosVertices[idx];
+}
+
+double GrafoCSR::getPesoAresta(int origem, int destino) const {
+  CONTA_CHAMADA(OP_GET_PESO_ARESTA);
+  int o = origem - 1;
+  int d = destino - 1;
+  if (o < 0 || o >= nNos || d < 0 || d >= nNos)
+    return INF;
+  int e = busca_entrada(o, d);
+  if (e < 0)
+    return INF;
+  return (double)pesos[e];
+}
+
+int GrafoCSR::get_num_arestas() const {
+  return (direcionado ? nEntradas : nEntradas / 2);
+}
+
+int GrafoCSR::get_grau_entrada(int vertice) const {
+  int idx = vertice - 1;
+  if (idx < 0 || idx >= nNos)
+    return 0;
+  if (!direcionado)
+    return offsets[idx + 1] - offsets[idx];
+  return roffsets[idx + 1] - roffsets[idx];
+}
+
+void GrafoCSR::percorre_predecessores(int vertice,
+                                      VisitanteVizinhos &visitante) const {
+  if (!direcionado) {
+    percorre_vizinhos(vertice, visitante);
+    return;
+  }
+  int idx = vertice - 1;
+  if (idx < 0 || idx >= nNos)
+    return;
+  for (int e = roffsets[idx]; e < roffsets[idx + 1]; e++) {
+    if (!visitante.visita(rorigens[e] + 1, rpesos[e]))
+      return;
+  }
+}
+
+void GrafoCSR::novo_no(int peso) {
+  INSTRUMENTA(OP_NOVO_NO);
+  inserir_vertice(nNos + 1, peso);
+  ordem++;
+}
+
+void GrafoCSR::nova_aresta(int origem, int destino, int peso) {
+  INSTRUMENTA(OP_NOVA_ARESTA);
+  inserir_aresta(origem, destino, peso);
+}
+
+void GrafoCSR::altera_peso_aresta(int origem, int destino, int peso) {
+  INSTRUMENTA(OP_ALTERA_PESO_ARESTA);
+  int o = origem - 1;
+  int d = destino - 1;
+  int e = (o >= 0 && o < nNos && d >= 0 && d < nNos && construido
+               ? busca_entrada(o, d)
+               : -1);
+  if (e < 0) {
+    cerr << "Erro: Aresta de " << origem << " para " << destino
+         << " não existe." << endl;
+    return;
+  }
+  // Só os pesos mudam: a estrutura não é reconstruída
+  desvincula_mapa();
+  int antigo = pesos[e];
+  pesos[e] = peso;
+  if (!direcionado) {
+    pesos[busca_entrada(d, o)] = peso;
+  } else {
+    // As origens de cada linha do CSR reverso também estão ordenadas
+    int ini = roffsets[d];
+    int fim = roffsets[d + 1] - 1;
+    while (ini <= fim) {
+      int meio = ini + (fim - ini) / 2;
+      if (rorigens[meio] == o) {
+        rpesos[meio] = peso;
+        break;
+      }
+      if (rorigens[meio] < o)
+        ini = meio + 1;
+      else
+        fim = meio - 1;
+    }
+  }
+  registra_peso(origem, destino, antigo, peso);
+}
+
+void GrafoCSR::deleta_no(int id) {
+  INSTRUMENTA(OP_DELETA_NO);
+  int index = id - 1;
+  if (index < 0 || index >= nNos) {
+    cerr << "Erro: Vértice " << id << " não existe." << endl;
+    return;
+  }
+  desvincula_mapa();
+  registra_remocao();
+
+  // Copia as linhas remanescentes, descartando as entradas que apontam para o
+  // nó removido e renumerando os destinos maiores que ele
+  int *novoOffsets = new int[nNos];
+  int *novoDestinos = new int[nEntradas];
+  int *novoPesos = new int[nEntradas];
+  int n = 0;
+  int newRow = 0;
+  for (int v = 0; v < nNos; v++) {
+    if (v == index)
+      continue;
+    novoOffsets[newRow++] = n;
+    for (int e = offsets[v]; e < offsets[v + 1]; e++) {
+      int w = destinos[e];
+      if (w == index)
+        continue;
+      novoDestinos[n] = (w > index ? w - 1 : w);
+      novoPesos[n] = pesos[e];
+      n++;
+    }
+  }
+  novoOffsets[newRow] = n;
+
+  for (int v = index; v < nNos - 1; v++)
+    pesosVertices[v] = pesosVertices[v + 1];
+
+  delete[] offsets;
+  delete[] destinos;
+  delete[] pesos;
+  offsets = novoOffsets;
+  destinos = novoDestinos;
+  pesos = novoPesos;
+  nEntradas = n;
+  nNos--;
+  nLinhas = nNos;
+  ordem = nNos;
+  constroi_reverso();
+}
+
+void GrafoCSR::deleta_aresta(int origem, int destino) {
+  INSTRUMENTA(OP_DELETA_ARESTA);
+  int o = origem - 1;
+  int d = destino - 1;
+  if (o < 0 || o >= nNos || d < 0 || d >= nNos) {
+    cerr << "Indices de aresta invalidos." << endl;
+    return;
+  }
+  desvincula_mapa();
+  registra_remocao();
+  for (int lado = 0; lado < (direcionado ? 1 : 2); lado++) {
+    int a = (lado == 0 ? o : d);
+    int b = (lado == 0 ? d : o);
+    int e = busca_entrada(a, b);
+    if (e < 0)
+      continue;
+    for (int i = e; i < nEntradas - 1; i++) {
+      destinos[i] = destinos[i + 1];
+      pesos[i] = pesos[i + 1];
+    }
+    for (int v = a + 1; v <= nNos; v++)
+      offsets[v]--;
+    nEntradas--;
+  }
+  constroi_reverso();
+}
+
+void GrafoCSR::deleta_nos(const int *ids, int k) {
+  INSTRUMENTA(OP_DELETA_NOS);
+  bool *removido = new bool[nNos > 0 ? nNos : 1];
+  int nRemovidos = marca_remocoes(ids, k, nNos, removido);
+  if (nRemovidos == 0) {
+    delete[] removido;
+    return;
+  }
+  desvincula_mapa();
+  registra_remocao();
+
+  // Novo índice de cada nó (-1 se removido), calculado uma única vez; como a
+  // renumeração preserva a ordem, as linhas continuam ordenadas
+  int *novoId = new int[nNos];
+  int vivos = 0;
+  for (int v = 0; v < nNos; v++)
+    novoId[v] = (removido[v] ? -1 : vivos++);
+
+  int *novoOffsets = new int[vivos + 1];
+  int *novoDestinos = new int[nEntradas > 0 ? nEntradas : 1];
+  int *novoPesos = new int[nEntradas > 0 ? nEntradas : 1];
+  int n = 0;
+  for (int v = 0; v < nNos; v++) {
+    if (removido[v])
+      continue;
+    novoOffsets[novoId[v]] = n;
+    pesosVertices[novoId[v]] = pesosVertices[v];
+    for (int e = offsets[v]; e < offsets[v + 1]; e++) {
+      int w = novoId[destinos[e]];
+      if (w < 0)
+        continue;
+      novoDestinos[n] = w;
+      novoPesos[n] = pesos[e];
+      n++;
+    }
+  }
+  novoOffsets[vivos] = n;
+  delete[] removido;
+  delete[] novoId;
+
+  delete[] offsets;
+  delete[] destinos;
+  delete[] pesos;
+  offsets = novoOffsets;
+  destinos = novoDestinos;
+  pesos = novoPesos;
+  nEntradas = n;
+  nNos = vivos;
+  nLinhas = nNos;
+  ordem = nNos;
+  constroi_reverso();
+}
+
+void GrafoCSR::deleta_arestas(const int *origensLote,
+                              const int *destinosLote, int n) {
+  INSTRUMENTA(OP_DELETA_ARESTAS);
+  bool *apagar = nullptr;
+  for (int i = 0; i < n; i++) {
+    int o = origensLote[i] - 1;
+    int d = destinosLote[i] - 1;
+    if (o < 0 || o >= nNos || d < 0 || d >= nNos) {
+      cerr << "Indices de aresta invalidos." << endl;
+      continue;
+    }
+    if (apagar == nullptr) {
+      desvincula_mapa();
+      registra_remocao();
+      apagar = new bool[nEntradas > 0 ? nEntradas : 1];
+      for (int e = 0; e < nEntradas; e++)
+        apagar[e] = false;
+    }
+    for (int lado = 0; lado < (direcionado ? 1 : 2); lado++) {
+      int e = (lado == 0 ? busca_entrada(o, d) : busca_entrada(d, o));
+      if (e >= 0)
+        apagar[e] = true;
+    }
+  }
+  if (apagar == nullptr)
+    return;
+
+  // Compacta os vetores no local, em uma passada
+  int k = 0;
+  for (int v = 0; v < nNos; v++) {
+    int ini = offsets[v];
+    offsets[v] = k;
+    for (int e = ini; e < offsets[v + 1]; e++) {
+      if (apagar[e])
+        continue;
+      destinos[k] = destinos[e];
+      pesos[k] = pesos[e];
+      k++;
+    }
+  }
+  offsets[nNos] = k;
+  nEntradas = k;
+  delete[] apagar;
+  constroi_reverso();
+}
+
+void GrafoCSR::imprime_grafo() const {
+  std::cout << "Grafo (CSR):" << std::endl;
+  std::cout << "Ordem: " << ordem << std::endl;
+  for (int i = 0; i < nNos; i++) {
+    std::cout << "Vértice " << (i + 1);
+    if (ponderadoVertices)
+      std::cout << " (peso: " << pesosVertices[i] << ")";
+    std::cout << " -> ";
+    if (offsets[i] == offsets[i + 1])
+      std::cout << "Sem vizinhos";
+    for (int e = offsets[i]; e < offsets[i + 1]; e++) {
+      std::cout << (destinos[e] + 1);
+      if (ponderadoArestas)
+        std::cout << " (peso: " << pesos[e] << ")";
+      std::cout << " ";
+    }
+    std::cout << std::endl;
+  }
+}
@@ -5,9 +5,15 @@
 #include <iostream>
 using namespace std;
 
-GrafoLista::GrafoLista() { vertices = new ListaEncadeada<Vertice *>(); }
+GrafoLista::GrafoLista()
+    : indice(nullptr), capIndice(0), arestasSemDestino(0) {
+  vertices = new ListaEncadeada<Vertice *>(&arenaVertices);
+}
 
 GrafoLista::~GrafoLista() {
+  // Os nós das listas são liberados junto com as arenas, bloco a bloco
+  arenaArestas.descarta_tudo();
+  arenaVertices.descarta_tudo();
   // Itera sobre a lista de vértices e deleta cada um
   No<Vertice *> *no = vertices->getHead();
   while (no) {
@@ -15,35 +21,222 @@ GrafoLista::~GrafoLista() {
     no = no->prox;
   }
   delete vertices;
+  delete[] indice;
+}
+
+// Garante que o índice comporte o id (a capacidade dobra quando necessário)
+void GrafoLista::reserva_indice(int id) {
+  if (id <= capIndice)
+    return;
+  int novaCapacidade = (capIndice == 0 ? 16 : capIndice * 2);
+  while (novaCapacidade < id)
+    novaCapacidade *= 2;
+  Vertice **novo = new Vertice *[novaCapacidade + 1];
+  for (int i = 0; i <= capIndice; i++)
+    novo[i] = (indice != nullptr ? indice[i] : nullptr);
+  for (int i = capIndice + 1; i <= novaCapacidade; i++)
+    novo[i] = nullptr;
+  delete[] indice;
+  indice = novo;
+  capIndice = novaCapacidade;
 }
 
 void GrafoLista::inserir_vertice(int id, int peso) {
-  Vertice *v = new Vertice(id, peso);
+  INSTRUMENTA(OP_INSERIR_VERTICE);
+  Vertice *v = new Vertice(id, peso, &arenaArestas);
   vertices->append(v);
+  reserva_indice(id);
+  indice[id] = v;
+  if (arestasSemDestino > 0)
+    registra_entradas_pendentes(v);
+  registra_vertice();
 }
 
-Vertice *GrafoLista::encontrar_vertice(int id) const {
-  No<Vertice *> *no = vertices->getHead();
-  while (no) {
-    if (no->dado->id == id)
-      return no->dado;
-    no = no->prox;
+// Em grafos direcionados uma aresta pode apontar para um id ainda
+// inexistente; quando ele é criado, a aresta passa a contar como entrada
+void GrafoLista::registra_entradas_pendentes(Vertice *novo) {
+  int restantes = 0;
+  No<Vertice *> *atual = vertices->getHead();
+  while (atual != nullptr) {
+    No<Aresta> *no = atual->dado->arestas->getHead();
+    while (no != nullptr) {
+      int d = no->dado.destino;
+      if (d == novo->id)
+        registra_entrada(atual->dado->id, novo, no->dado.peso);
+      else if (d >= 1 && encontrar_vertice(d) == nullptr)
+        restantes++;
+      no = no->prox;
+    }
+    atual = atual->prox;
   }
-  return 0;
+  arestasSemDestino = restantes;
+}
+
+// As repetições do lote são detectadas agrupando as arestas por origem (em
+// grafos não direcionados, pelo menor extremo) com um counting sort estável
+// e marcando os destinos já vistos, em O(V+E) no total, em vez de percorrer
+// a lista da origem a cada aresta. As arestas aceitas são depois inseridas
+// na ordem do lote, como faria inserir_aresta.
+void GrafoLista::inserir_arestas_lote(const int *origens, const int *destinos,
+                                      const int *pesos, int n) {
+  INSTRUMENTA(OP_INSERIR_ARESTAS_LOTE);
+  garante_compacto();
+  // Arestas para nós inexistentes têm tratamento próprio em inserir_aresta
+  for (int i = 0; i < n; i++) {
+    if (origens[i] != destinos[i] && encontrar_vertice(origens[i]) &&
+        !encontrar_vertice(destinos[i])) {
+      Grafo::inserir_arestas_lote(origens, destinos, pesos, n);
+      return;
+    }
+  }
+
+  enum { ACEITA, LACO, SEM_ORIGEM, REPETIDA };
+  unsigned char *situacao = new unsigned char[n > 0 ? n : 1];
+  int *grupo = new int[n > 0 ? n : 1]; // 0: já recusada
+  int *cont = new int[ordem + 2];
+  for (int u = 0; u <= ordem + 1; u++)
+    cont[u] = 0;
+  for (int i = 0; i < n; i++) {
+    int o = origens[i];
+    int d = destinos[i];
+    grupo[i] = 0;
+    if (o == d) {
+      situacao[i] = LACO;
+    } else if (!encontrar_vertice(o)) {
+      situacao[i] = SEM_ORIGEM;
+    } else {
+      situacao[i] = ACEITA;
+      grupo[i] = (direcionado || o < d ? o : d);
+      cont[grupo[i] + 1]++;
+    }
+  }
+  for (int u = 0; u <= ordem; u++)
+    cont[u + 1] += cont[u];
+  int *ordenadas = new int[cont[ordem + 1] > 0 ? cont[ordem + 1] : 1];
+  int *pos = new int[ordem + 1];
+  for (int u = 0; u <= ordem; u++)
+    pos[u] = cont[u];
+  for (int i = 0; i < n; i++) {
+    if (grupo[i] != 0)
+      ordenadas[pos[grupo[i]]++] = i;
+  }
+  delete[] pos;
+
+  int *marca = new int[ordem + 1];
+  for (int w = 0; w <= ordem; w++)
+    marca[w] = 0;
+  for (int u = 1; u <= ordem; u++) {
+    if (cont[u] == cont[u + 1])
+      continue;
+    // Arestas já existentes do grupo
+    for (No<Aresta> *no = encontrar_vertice(u)->arestas->getHead(); no;
+         no = no->prox) {
+      int w = no->dado.destino;
+      if (w >= 1 && w <= ordem && (direcionado || w > u))
+        marca[w] = u;
+    }
+    for (int k = cont[u]; k < cont[u + 1]; k++) {
+      int i = ordenadas[k];
+      int w = (origens[i] == u ? destinos[i] : origens[i]);
+      if (marca[w] == u)
+        situacao[i] = REPETIDA;
+      else
+        marca[w] = u;
+    }
+  }
+  delete[] marca;
+  delete[] ordenadas;
+  delete[] cont;
+  delete[] grupo;
+
+  for (int i = 0; i < n; i++) {
+    int o = origens[i];
+    int d = destinos[i];
+    switch (situacao[i]) {
+    case LACO:
+      if (reporta_recusa())
+        cerr << "Erro: Laço não permitido (origem e destino iguais: " << o
+             << ")." << endl;
+      break;
+    case SEM_ORIGEM:
+      if (reporta_recusa())
+        cerr << "Erro: Vértice " << o << " não encontrado." << endl;
+      break;
+    case REPETIDA:
+      if (reporta_recusa())
+        cerr << "Erro: Aresta de " << o << " para " << d << " já existe."
+             << endl;
+      break;
+    default: {
+      Vertice *v = encontrar_vertice(o);
+      Vertice *v2 = encontrar_vertice(d);
+      v->arestas->inserir(Aresta(d, pesos[i]));
+      registra_aresta(o, d, pesos[i]);
+      registra_entrada(o, v2, pesos[i]);
+      if (!direcionado) {
+        v2->arestas->inserir(Aresta(o, pesos[i]));
+        registra_entrada(d, v, pesos[i]);
+      }
+    }
+    }
+  }
+  delete[] situacao;
+}
+
+// Cada aresta ocupa dois nós de lista: um em cada sentido (não direcionado)
+// ou um na lista da origem e outro no índice reverso do destino
+void GrafoLista::reserva(int nVertices, int nArestas) {
+  reserva_indice(nVertices);
+  arenaVertices.reserva(nVertices);
+  arenaArestas.reserva(2 * (long long)nArestas);
+}
+
+// Remove da lista a primeira aresta com o destino informado
+static bool remove_da_lista(ListaEncadeada<Aresta> *lista, int destino) {
+  No<Aresta> *atual = lista->getHead();
+  No<Aresta> *anterior = nullptr;
+  while (atual != nullptr) {
+    if (atual->dado.destino == destino) {
+      lista->remove_apos(anterior);
+      return true;
+    }
+    anterior = atual;
+    atual = atual->prox;
+  }
+  return false;
+}
+
+void GrafoLista::registra_entrada(int origem, Vertice *destino, int peso) {
+  destino->grauEntrada++;
+  if (direcionado) {
+    if (destino->predecessores == nullptr)
+      destino->predecessores = new ListaEncadeada<Aresta>(&arenaArestas);
+    destino->predecessores->inserir(Aresta(origem, peso));
+  }
+}
+
+void GrafoLista::remove_entrada(int origem, Vertice *destino) {
+  destino->grauEntrada--;
+  if (direcionado && destino->predecessores != nullptr)
+    remove_da_lista(destino->predecessores, origem);
 }
 
 void GrafoLista::inserir_aresta(int origem, int destino, int peso) {
+  INSTRUMENTA(OP_INSERIR_ARESTA);
+  garante_compacto();
   // Validação: não permitir laços
   if (origem == destino) {
-    cerr << "Erro: Laço não permitido (origem e destino iguais: " << origem
-         << ")." << endl;
+    if (reporta_recusa())
+      cerr << "Erro: Laço não permitido (origem e destino iguais: " << origem
+           << ")." << endl;
     return;
   }
 
   // Busca o vértice de origem
   Vertice *v = encontrar_vertice(origem);
   if (!v) {
-    cerr << "Erro: Vértice " << origem << " não encontrado." << endl;
+    if (reporta_recusa())
+      cerr << "Erro: Vértice " << origem << " não encontrado." << endl;
     return;
   }
 
@@ -51,8 +244,9 @@ void GrafoLista::inserir_aresta(int origem, int destino, int peso) {
   No<Aresta> *no = v->arestas->getHead();
   while (no) {
     if (no->dado.destino == destino) {
-      cerr << "Erro: Aresta de " << origem << " para " << destino
-           << " já existe." << endl;
+      if (reporta_recusa())
+        cerr << "Erro: Aresta de " << origem << " para " << destino
+             << " já existe." << endl;
       return;
     }
     no = no->prox;
@@ -60,49 +254,116 @@ void GrafoLista::inserir_aresta(int origem, int destino, int peso) {
 
   // Se não houver conflito, insere a aresta na lista do vértice de origem
   v->arestas->inserir(Aresta(destino, peso));
+  registra_aresta(origem, destino, peso);
+  Vertice *v2 = encontrar_vertice(destino);
+  if (v2)
+    registra_entrada(origem, v2, peso);
+  else if (direcionado && destino >= 1)
+    arestasSemDestino++;
 
   // Se o grafo não for direcionado, insere a aresta simetricamente
   if (!direcionado) {
-    Vertice *v2 = encontrar_vertice(destino);
     if (!v2) {
-      cerr << "Erro: Vértice " << destino << " não encontrado." << endl;
+      if (reporta_recusa())
+        cerr << "Erro: Vértice " << destino << " não encontrado." << endl;
       return;
     }
     // Verifica se a aresta reversa já existe na lista do vértice de destino
     no = v2->arestas->getHead();
     while (no) {
       if (no->dado.destino == origem) {
-        cerr << "Erro: Aresta de " << destino << " para " << origem
-             << " já existe." << endl;
+        if (reporta_recusa())
+          cerr << "Erro: Aresta de " << destino << " para " << origem
+               << " já existe." << endl;
         return;
       }
       no = no->prox;
     }
     v2->arestas->inserir(Aresta(origem, peso));
+    registra_entrada(destino, v, peso);
   }
 }
 
-IntList GrafoLista::get_vizinhos(int id) const {
-  IntList lista;
+void GrafoLista::percorre_vizinhos(int id,
+                                   VisitanteVizinhos &visitante) const {
+  garante_compacto();
   Vertice *v = encontrar_vertice(id);
   if (!v)
-    return lista;
+    return;
   No<Aresta> *no = v->arestas->getHead();
   while (no) {
-    lista.add(no->dado.destino);
+    if (!visitante.visita(no->dado.destino, no->dado.peso))
+      return;
     no = no->prox;
   }
-  return lista;
+}
+
+int GrafoLista::get_num_arestas() const {
+  int total = 0;
+  int n = posicoesVivas.tamanho();
+  No<Vertice *> *atual = vertices->getHead();
+  while (atual != nullptr) {
+    No<Aresta> *no = atual->dado->arestas->getHead();
+    while (no != nullptr) {
+      // Com remoções pendentes, ignora as arestas que compacta() descartará
+      // (destinos fora de 1..n, aceitos em grafos direcionados, ficam)
+      int d = no->dado.destino;
+      if (removidosPendentes == 0 || d < 1 || d > n ||
+          posicoesVivas.esta_viva(d))
+        total++;
+      no = no->prox;
+    }
+    atual = atual->prox;
+  }
+  return (direcionado ? total : total / 2);
+}
+
+int GrafoLista::get_grau_entrada(int id) const {
+  garante_compacto();
+  Vertice *v = encontrar_vertice(id);
+  if (!v)
+    return 0;
+  return v->grauEntrada;
+}
+
+void GrafoLista::percorre_predecessores(int id,
+                                        VisitanteVizinhos &visitante) const {
+  garante_compacto();
+  if (!direcionado) {
+    percorre_vizinhos(id, visitante);
+    return;
+  }
+  Vertice *v = encontrar_vertice(id);
+  if (!v || v->predecessores == nullptr)
+    return;
+  No<Aresta> *no = v->predecessores->getHead();
+  while (no) {
+    if (!visitante.visita(no->dado.destino, no->dado.peso))
+      return;
+    no = no->prox;
+  }
+}
+
+int GrafoLista::get_peso_vertice(int id) const {
+  garante_compacto();
+  Vertice *v = encontrar_vertice(id);
+  if (!v)
+    return 0;
+  return v->peso;
 }
 
 void GrafoLista::novo_no(int peso) {
-  // Cria um novo vértice com id = ordem + 1 e o insere na lista
-  Vertice *novo = new Vertice(ordem + 1, peso);
-  vertices->inserir(novo);
+  INSTRUMENTA(OP_NOVO_NO);
+  // Cria um novo vértice com id = ordem + 1 (ou o próximo id interno, se
+  // houver remoções pendentes) e o insere no final da lista
+  int id = (removidosPendentes > 0 ? posicoesVivas.adiciona() : ordem + 1);
+  inserir_vertice(id, peso);
   ordem++;
 }
 
 void GrafoLista::nova_aresta(int origem, int destino, int peso) {
+  INSTRUMENTA(OP_NOVA_ARESTA);
+  garante_compacto();
   if (origem == destino) {
     cerr << "Erro: Laço não permitido." << endl;
     return;
@@ -123,8 +384,13 @@ void GrafoLista::nova_aresta(int origem, int destino, int peso) {
     no = no->prox;
   }
   v->arestas->inserir(Aresta(destino, peso));
+  registra_aresta(origem, destino, peso);
+  Vertice *v2 = encontrar_vertice(destino);
+  if (v2)
+    registra_entrada(origem, v2, peso);
+  else if (direcionado && destino >= 1)
+    arestasSemDestino++;
   if (!direcionado) {
-    Vertice *v2 = encontrar_vertice(destino);
     if (!v2) {
       cerr << "Erro: Vértice " << destino << " não encontrado." << endl;
       return;
@@ -137,130 +403,315 @@ void GrafoLista::nova_aresta(int origem, int destino, int peso) {
       no = no->prox;
     }
     v2->arestas->inserir(Aresta(origem, peso));
+    registra_entrada(destino, v, peso);
   }
 }
 
-void GrafoLista::deleta_no(int id) {
-  // 1. Remover o vértice da lista de vértices
-  No<Vertice *> *atual = vertices->getHead();
-  No<Vertice *> *anterior = nullptr;
-  bool removido = false;
-  while (atual != nullptr) {
-    if (atual->dado->id == id) {
-      if (anterior == nullptr) {
-        // Atualize o head da lista
-        vertices->setHead(atual->prox);
-      } else {
-        anterior->prox = atual->prox;
-      }
-      // Libere as arestas e o vértice
-      delete atual->dado;
-      delete atual;
-      removido = true;
-      ordem--; // Atualize a ordem
-      break;
+// Troca o peso da entrada 'destino' da lista; retorna false se não existir
+static bool troca_peso(ListaEncadeada<Aresta> *lista, int destino, int peso,
+                       int &antigo) {
+  for (No<Aresta> *no = lista->getHead(); no != nullptr; no = no->prox) {
+    if (no->dado.destino == destino) {
+      antigo = no->dado.peso;
+      no->dado.peso = peso;
+      return true;
     }
-    anterior = atual;
-    atual = atual->prox;
   }
-  if (!removido) {
+  return false;
+}
+
+void GrafoLista::altera_peso_aresta(int origem, int destino, int peso) {
+  INSTRUMENTA(OP_ALTERA_PESO_ARESTA);
+  garante_compacto();
+  Vertice *v = encontrar_vertice(origem);
+  int antigo;
+  if (!v || !troca_peso(v->arestas, destino, peso, antigo)) {
+    cerr << "Erro: Aresta de " << origem << " para " << destino
+         << " não existe." << endl;
+    return;
+  }
+  // A cópia da aresta no destino: a reversa (não direcionado) ou a entrada
+  // do índice de predecessores
+  Vertice *v2 = encontrar_vertice(destino);
+  int ignorado;
+  if (v2 && !direcionado)
+    troca_peso(v2->arestas, origem, peso, ignorado);
+  else if (v2 && v2->predecessores != nullptr)
+    troca_peso(v2->predecessores, origem, peso, ignorado);
+  registra_peso(origem, destino, antigo, peso);
+}
+
+// Remove o nó: as arestas que saem dele e as que chegam a ele são retiradas
+// das listas dos vizinhos, o vértice é liberado e o seu id interno é marcado
+// como removido. O nó da lista de vértices fica vazio (nullptr) até a
+// compactação, que é feita em seguida se o modo de remoção adiada estiver
+// desligado.
+void GrafoLista::deleta_no(int id) {
+  INSTRUMENTA(OP_DELETA_NO);
+  int pos = (id >= 1 ? posicao_do_id(id) : -1);
+  // 1. Retirar o vértice do índice
+  Vertice *x = encontrar_vertice(pos);
+  if (x == nullptr) {
     cerr << "Erro: Vértice " << id << " não existe." << endl;
     return;
   }
+  indice[pos] = nullptr;
+  registra_remocao();
 
-  // 2. Remover de todas as listas de arestas quaisquer referências ao nó
-  // removido
-  atual = vertices->getHead();
-  while (atual != nullptr) {
-    No<Aresta> *atAresta = atual->dado->arestas->getHead();
-    No<Aresta> *antAresta = nullptr;
-    while (atAresta != nullptr) {
-      if (atAresta->dado.destino == id) {
-        if (antAresta == nullptr) {
-          atual->dado->arestas->setHead(atAresta->prox);
-        } else {
-          antAresta->prox = atAresta->prox;
-        }
-        No<Aresta> *temp = atAresta;
-        atAresta = atAresta->prox;
-        delete temp;
-      } else {
-        antAresta = atAresta;
-        atAresta = atAresta->prox;
+  // 2. Remover as referências ao nó das listas dos seus vizinhos, atualizando
+  // os graus de entrada e o índice reverso
+  No<Aresta> *no = x->arestas->getHead();
+  while (no != nullptr) {
+    Vertice *w = encontrar_vertice(no->dado.destino);
+    // O grau de entrada só conta arestas registradas (o destino existia
+    // quando a aresta foi inserida)
+    if (w != nullptr) {
+      if (direcionado) {
+        if (w->predecessores != nullptr &&
+            remove_da_lista(w->predecessores, pos))
+          w->grauEntrada--;
+      } else if (remove_da_lista(w->arestas, pos)) {
+        w->grauEntrada--; // a aresta simétrica w -> x também deixou de existir
       }
     }
-    atual = atual->prox;
+    no = no->prox;
   }
+  if (direcionado && x->predecessores != nullptr) {
+    no = x->predecessores->getHead();
+    while (no != nullptr) {
+      Vertice *u = encontrar_vertice(no->dado.destino);
+      if (u != nullptr)
+        remove_da_lista(u->arestas, pos);
+      no = no->prox;
+    }
+  }
+  // O vértice fica na lista, sem arestas e com id 0, até a compactação
+  delete x->arestas;
+  x->arestas = new ListaEncadeada<Aresta>(&arenaArestas);
+  delete x->predecessores;
+  x->predecessores = nullptr;
+  x->id = 0;
+
+  if (removidosPendentes == 0)
+    posicoesVivas.reinicia(ordem);
+  posicoesVivas.remove(pos);
+  removidosPendentes++;
+  ordem--; // Atualize a ordem
 
-  // 3. Reindexar os nós restantes (supondo que os nós na lista devem ser
-  // numerados de 1 a ordem)
-  int novoId = 1;
-  atual = vertices->getHead();
+  // 3. Sem remoção adiada, reindexar imediatamente
+  if (!remocaoAdiada)
+    compacta();
+}
+
+// Reindexa os nós restantes (numerados de 1 a ordem, preservando a ordem
+// relativa dos ids) e atualiza as referências das arestas e do índice
+// reverso, em uma única passada.
+void GrafoLista::compacta() {
+  INSTRUMENTA(OP_COMPACTA);
+  if (removidosPendentes == 0)
+    return;
+  int n = posicoesVivas.tamanho();
+  // novoId[i] = novo id da posição i (0 se removida). Arestas para ids além
+  // dos nós existentes (permitidas em grafos direcionados) são deslocadas
+  // pelo total de removidos.
+  int *novoId = new int[n + 1];
+  novoId[0] = 0;
+  int vivos = 0;
+  for (int i = 1; i <= n; i++)
+    novoId[i] = (posicoesVivas.esta_viva(i) ? ++vivos : 0);
+
+  // Libera os vértices removidos (id 0), renumera os demais e reconstrói o
+  // índice
+  for (int i = 1; i <= capIndice; i++)
+    indice[i] = nullptr;
+  No<Vertice *> *atual = vertices->getHead();
+  No<Vertice *> *anterior = nullptr;
   while (atual != nullptr) {
-    atual->dado->id = novoId;
-    novoId++;
+    Vertice *v = atual->dado;
+    if (v->id == 0) {
+      delete v;
+      atual = vertices->remove_apos(anterior);
+      continue;
+    }
+    v->id = novoId[v->id];
+    indice[v->id] = v;
+    renumera_lista(v->arestas, novoId, n);
+    if (v->predecessores != nullptr)
+      renumera_lista(v->predecessores, novoId, n);
+    anterior = atual;
     atual = atual->prox;
   }
+  delete[] novoId;
+  removidosPendentes = 0;
+}
 
-  // 4. Atualizar as referências das arestas: se o destino > id removido,
-  // subtrair 1.
-  atual = vertices->getHead();
+// Atualiza os ids de uma lista de arestas conforme novoId (ver compacta),
+// descartando as que ainda apontam para nós removidos (arestas para um id
+// que não existia quando foram inseridas não constam no índice reverso)
+void GrafoLista::renumera_lista(ListaEncadeada<Aresta> *lista,
+                                const int *novoId, int n) {
+  No<Aresta> *atual = lista->getHead();
+  No<Aresta> *anterior = nullptr;
   while (atual != nullptr) {
-    No<Aresta> *atAresta = atual->dado->arestas->getHead();
-    while (atAresta != nullptr) {
-      if (atAresta->dado.destino > id) {
-        atAresta->dado.destino -= 1;
-      }
-      atAresta = atAresta->prox;
+    int d = atual->dado.destino;
+    // Ids não positivos (aceitos como destino sem validação) ficam como estão
+    int novo = (d < 1 ? d : d <= n ? novoId[d] : d - removidosPendentes);
+    if (d >= 1 && novo == 0) {
+      atual = lista->remove_apos(anterior);
+      continue;
     }
+    atual->dado.destino = novo;
+    anterior = atual;
     atual = atual->prox;
   }
 }
 
 void GrafoLista::deleta_aresta(int origem, int destino) {
+  INSTRUMENTA(OP_DELETA_ARESTA);
+  garante_compacto();
   Vertice *v = encontrar_vertice(origem);
   if (!v) {
     cerr << "Erro: Vértice " << origem << " não encontrado." << endl;
     return;
   }
-  No<Aresta> *atual = v->arestas->getHead();
-  No<Aresta> *anterior = nullptr;
-  while (atual != nullptr) {
-    if (atual->dado.destino == destino) {
-      if (anterior == nullptr) {
-        v->arestas->setHead(atual->prox);
-      } else {
-        anterior->prox = atual->prox;
+  registra_remocao();
+  Vertice *v2 = encontrar_vertice(destino);
+  if (remove_da_lista(v->arestas, destino) && v2)
+    remove_entrada(origem, v2);
+  if (!direcionado && v2) {
+    if (remove_da_lista(v2->arestas, origem))
+      remove_entrada(destino, v);
+  }
+}
+
+// Remove as entradas (dono[i], alvo[i]) das listas de arestas (ou de
+// predecessores) dos donos: as entradas são agrupadas por dono com um
+// counting sort e cada lista é percorrida uma única vez, em vez de uma vez
+// por entrada. As entradas efetivamente removidas são copiadas para o início
+// de dono/alvo; retorna a quantidade.
+int GrafoLista::remove_entradas(int *dono, int *alvo, int m,
+                                bool predecessores) {
+  int n = ordem;
+  int *cont = new int[n + 2];
+  for (int u = 0; u <= n + 1; u++)
+    cont[u] = 0;
+  for (int i = 0; i < m; i++)
+    cont[dono[i] + 1]++;
+  for (int u = 0; u <= n; u++)
+    cont[u + 1] += cont[u];
+  int *ordenadas = new int[m > 0 ? m : 1];
+  for (int i = 0; i < m; i++)
+    ordenadas[cont[dono[i]]++] = i;
+  // cont[u] agora é o fim do grupo de u (e o início do grupo de u + 1)
+
+  int *marca = new int[n + 1];
+  for (int w = 0; w <= n; w++)
+    marca[w] = 0;
+  int *remDono = new int[m > 0 ? m : 1];
+  int *remAlvo = new int[m > 0 ? m : 1];
+  int r = 0;
+  for (int u = 1; u <= n; u++) {
+    int ini = cont[u - 1];
+    int fim = cont[u];
+    Vertice *v = encontrar_vertice(u);
+    if (ini == fim || v == nullptr)
+      continue;
+    ListaEncadeada<Aresta> *lista = (predecessores ? v->predecessores
+                                                   : v->arestas);
+    if (lista == nullptr)
+      continue;
+    bool temMarcadas = false;
+    for (int g = ini; g < fim; g++) {
+      int t = alvo[ordenadas[g]];
+      if (t >= 1 && t <= n) {
+        marca[t] = u;
+        temMarcadas = true;
+      } else if (remove_da_lista(lista, t)) {
+        // Destino além dos nós existentes (grafos direcionados)
+        remDono[r] = u;
+        remAlvo[r++] = t;
       }
-      delete atual;
-      break;
     }
-    anterior = atual;
-    atual = atual->prox;
-  }
-  if (!direcionado) {
-    Vertice *v2 = encontrar_vertice(destino);
-    if (v2) {
-      atual = v2->arestas->getHead();
-      anterior = nullptr;
-      while (atual != nullptr) {
-        if (atual->dado.destino == origem) {
-          if (anterior == nullptr) {
-            v2->arestas->setHead(atual->prox);
-          } else {
-            anterior->prox = atual->prox;
-          }
-          delete atual;
-          break;
-        }
-        anterior = atual;
-        atual = atual->prox;
+    if (!temMarcadas)
+      continue;
+    No<Aresta> *atual = lista->getHead();
+    No<Aresta> *anterior = nullptr;
+    while (atual != nullptr) {
+      int t = atual->dado.destino;
+      if (t >= 1 && t <= n && marca[t] == u) {
+        marca[t] = 0; // como remove_da_lista, só a primeira ocorrência
+        remDono[r] = u;
+        remAlvo[r++] = t;
+        atual = lista->remove_apos(anterior);
+        continue;
       }
+      anterior = atual;
+      atual = atual->prox;
+    }
+  }
+  for (int i = 0; i < r; i++) {
+    dono[i] = remDono[i];
+    alvo[i] = remAlvo[i];
+  }
+  delete[] cont;
+  delete[] ordenadas;
+  delete[] marca;
+  delete[] remDono;
+  delete[] remAlvo;
+  return r;
+}
+
+void GrafoLista::deleta_arestas(const int *origens, const int *destinos,
+                                int n) {
+  INSTRUMENTA(OP_DELETA_ARESTAS);
+  garante_compacto();
+  // Entradas a remover das listas de arestas; em grafos não direcionados a
+  // aresta também sai da lista do destino
+  int *dono = new int[2 * n + 1];
+  int *alvo = new int[2 * n + 1];
+  int m = 0;
+  bool alguma = false;
+  for (int i = 0; i < n; i++) {
+    if (!encontrar_vertice(origens[i])) {
+      cerr << "Erro: Vértice " << origens[i] << " não encontrado." << endl;
+      continue;
+    }
+    alguma = true;
+    dono[m] = origens[i];
+    alvo[m++] = destinos[i];
+    if (!direcionado && encontrar_vertice(destinos[i])) {
+      dono[m] = destinos[i];
+      alvo[m++] = origens[i];
     }
   }
+  if (alguma)
+    registra_remocao();
+
+  // Cada entrada removida de u -> t reduz o grau de entrada de t e, em
+  // grafos direcionados, sai do índice reverso de t
+  int r = remove_entradas(dono, alvo, m, false);
+  int nReversas = 0;
+  for (int i = 0; i < r; i++) {
+    int u = dono[i];
+    int t = alvo[i];
+    Vertice *w = encontrar_vertice(t);
+    if (w == nullptr)
+      continue;
+    w->grauEntrada--;
+    if (direcionado && w->predecessores != nullptr) {
+      dono[nReversas] = t;
+      alvo[nReversas++] = u;
+    }
+  }
+  if (nReversas > 0)
+    remove_entradas(dono, alvo, nReversas, true);
+  delete[] dono;
+  delete[] alvo;
 }
 
 double GrafoLista::getPesoAresta(int origem, int destino) const {
+  CONTA_CHAMADA(OP_GET_PESO_ARESTA);
+  garante_compacto();
   Vertice *v = encontrar_vertice(origem);
   if (!v)
     return 1e9;
@@ -273,6 +724,7 @@ double GrafoLista::getPesoAresta(int origem, int destino) const {
   return 1e9;
 }
 void GrafoLista::imprime_grafo() const {
+  garante_compacto();
   std::cout << "Grafo (Lista de Adjacência):" << std::endl;
   std::cout << "Ordem: " << ordem << std::endl;
   // Percorre a lista de vértices (assumindo que vertices->getHead() retorna um
@@ -283,14 +735,13 @@ void GrafoLista::imprime_grafo() const {
     if (ponderadoVertices)
       std::cout << " (peso: " << atual->dado->peso << ")";
     std::cout << " -> ";
-    // Obtém e imprime os vizinhos usando get_vizinhos
-    IntList vizinhos = get_vizinhos(atual->dado->id);
-    if (vizinhos.size() == 0) {
+    // Imprime os vizinhos diretamente da lista de arestas
+    No<Aresta> *no = atual->dado->arestas->getHead();
+    if (no == nullptr)
       std::cout << "Sem vizinhos";
-    } else {
-      for (int i = 0; i < vizinhos.size(); i++) {
-        std::cout << vizinhos.get(i) << " ";
-      }
+    while (no != nullptr) {
+      std::cout << no->dado.destino << " ";
+      no = no->prox;
     }
     std::cout << std::endl;
     atual = atual->prox;
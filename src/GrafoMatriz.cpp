@@ -1,129 +1,238 @@
 #include "../include/GrafoMatriz.hpp"
 #include "../include/IntList.hpp"
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <new>
 using namespace std;
 
 const double INF = 1e9;
 
+// As linhas começam em múltiplos de 64 bytes (16 ints)
+static const int ALINHAMENTO = 64;
+static const int INTS_POR_LINHA_CACHE = ALINHAMENTO / sizeof(int);
+
+// Aloca a matriz zerada (capacidade x passo)
+static int *aloca_matriz(int capacidade, int passo) {
+  size_t bytes = (size_t)capacidade * passo * sizeof(int);
+  void *p = nullptr;
+#if defined(_WIN32)
+  p = _aligned_malloc(bytes, ALINHAMENTO);
+#else
+  if (posix_memalign(&p, ALINHAMENTO, bytes) != 0)
+    p = nullptr;
+#endif
+  if (!p)
+    throw bad_alloc();
+  memset(p, 0, bytes);
+  return (int *)p;
+}
+
+static void libera_matriz(int *p) {
+#if defined(_WIN32)
+  _aligned_free(p);
+#else
+  free(p);
+#endif
+}
+
+static int calcula_passo(int capacidade) {
+  return (capacidade + INTS_POR_LINHA_CACHE - 1) / INTS_POR_LINHA_CACHE *
+         INTS_POR_LINHA_CACHE;
+}
+
 GrafoMatriz::GrafoMatriz()
-    : pesosVertices(nullptr), matriz(nullptr), capacidade(10), nNos(0) {
-  // Aloca o vetor de pesos e o array de ponteiros para as linhas da matriz
+    : pesosVertices(nullptr), matriz(nullptr), passo(0), grauSaida(nullptr),
+      grauEntrada(nullptr), capacidade(10), nNos(0) {
   pesosVertices = new int[capacidade];
-  matriz = new int *[capacidade];
-  // Inicializa todas as linhas como nullptr (para evitar acessos indevidos)
-  for (int i = 0; i < capacidade; i++) {
-    matriz[i] = nullptr;
-  }
+  grauSaida = new int[capacidade];
+  grauEntrada = new int[capacidade];
+  passo = calcula_passo(capacidade);
+  matriz = aloca_matriz(capacidade, passo);
 }
 
 GrafoMatriz::~GrafoMatriz() {
-  // Libera todas as linhas alocadas
-  for (int i = 0; i < nNos; i++) {
-    if (matriz[i] != nullptr) {
-      delete[] matriz[i];
-    }
-  }
-  delete[] matriz;
+  libera_matriz(matriz);
   delete[] pesosVertices;
+  delete[] grauSaida;
+  delete[] grauEntrada;
 }
 
+void GrafoMatriz::define_celula(int o, int d, int valor) {
+  int *c = linha(o) + d;
+  if (*c != 0) {
+    grauSaida[o]--;
+    grauEntrada[d]--;
+  }
+  *c = valor;
+  if (valor != 0) {
+    grauSaida[o]++;
+    grauEntrada[d]++;
+  }
+}
+
+// Acrescenta um nó ao final; a ordem é atualizada por novo_no (na carga ela
+// já foi lida do arquivo)
 void GrafoMatriz::inserir_vertice(int id, int peso) {
+  INSTRUMENTA(OP_INSERIR_VERTICE);
   (void)id;
-  novo_no(peso);
+  // A capacidade dobra quando cheia, então o custo da cópia é amortizado;
+  // a linha e a coluna do novo nó já estão zeradas
+  if (nNos >= capacidade) {
+    realocarMatriz(capacidade * 2);
+  }
+  pesosVertices[nNos] = peso;
+  grauSaida[nNos] = 0;
+  grauEntrada[nNos] = 0;
+  nNos++;
+  registra_vertice();
+  if (removidosPendentes > 0)
+    posicoesVivas.adiciona();
 }
 
 void GrafoMatriz::inserir_aresta(int origem, int destino, int peso) {
+  INSTRUMENTA(OP_INSERIR_ARESTA);
+  garante_compacto();
   int o = origem - 1;
   int d = destino - 1;
 
   if (origem == destino) {
-    cerr << "Erro: laço não permitido (origem == destino).\n";
+    if (reporta_recusa())
+      cerr << "Erro: laço não permitido (origem == destino).\n";
     return;
   }
-  if (matriz[o][d] != 0) {
-    cerr << "Erro: aresta já existe (aresta múltipla não permitida).\n";
+  if (o < 0 || o >= nNos || d < 0 || d >= nNos) {
+    if (reporta_recusa())
+      cerr << "Indices de aresta invalidos." << endl;
     return;
   }
-
-  if (o < 0 || o >= nNos || d < 0 || d >= nNos) {
-    cerr << "Indices de aresta invalidos." << endl;
+  if (celula(o, d) != 0) {
+    if (reporta_recusa())
+      cerr << "Erro: aresta já existe (aresta múltipla não permitida).\n";
     return;
   }
-  matriz[o][d] = peso;
+  define_celula(o, d, peso);
   if (!direcionado)
-    matriz[d][o] = peso;
+    define_celula(d, o, peso);
+  if (peso != 0)
+    registra_aresta(origem, destino, peso);
 }
 
-IntList GrafoMatriz::get_vizinhos(int vertice) const {
-  IntList lista;
+void GrafoMatriz::percorre_vizinhos(int vertice,
+                                    VisitanteVizinhos &visitante) const {
+  garante_compacto();
   int idx = vertice - 1;
   if (idx < 0 || idx >= nNos)
-    return lista;
+    return;
+  const int *l = linha(idx);
   for (int j = 0; j < nNos; j++) {
-    if (matriz[idx][j] != 0)
-      lista.add(j + 1);
+    if (l[j] != 0 && !visitante.visita(j + 1, l[j]))
+      return;
+  }
+}
+
+int GrafoMatriz::get_grau_saida(int vertice) const {
+  garante_compacto();
+  int idx = vertice - 1;
+  if (idx < 0 || idx >= nNos)
+    return 0;
+  return grauSaida[idx];
+}
+
+int GrafoMatriz::get_num_arestas() const {
+  int total = 0;
+  for (int i = 0; i < nNos; i++)
+    total += grauSaida[i];
+  return (direcionado ? total : total / 2);
+}
+
+int GrafoMatriz::get_grau_entrada(int vertice) const {
+  garante_compacto();
+  int idx = vertice - 1;
+  if (idx < 0 || idx >= nNos)
+    return 0;
+  return grauEntrada[idx];
+}
+
+// Os predecessores de um nó são as entradas não nulas da sua coluna
+void GrafoMatriz::percorre_predecessores(int vertice,
+                                         VisitanteVizinhos &visitante) const {
+  garante_compacto();
+  int idx = vertice - 1;
+  if (idx < 0 || idx >= nNos)
+    return;
+  const int *c = matriz + idx;
+  for (int i = 0; i < nNos; i++, c += passo) {
+    if (*c != 0 && !visitante.visita(i + 1, *c))
+      return;
   }
-  return lista;
 }
 
+int GrafoMatriz::get_peso_vertice(int vertice) const {
+  garante_compacto();
+  int idx = vertice - 1;
+  if (idx < 0 || idx >= nNos)
+    return 0;
+  return pesosVertices[idx];
+}
+
+// Copia a matriz para um novo bloco com outra capacidade (maior, ou menor
+// desde que caibam os nós atuais)
 void GrafoMatriz::realocarMatriz(int novaCapacidade) {
-  // Cria novo vetor de pesos e nova matriz
+  INSTRUMENTA(OP_REALOCAR_MATRIZ);
+  int novoPasso = calcula_passo(novaCapacidade);
+  int *novaMatriz = aloca_matriz(novaCapacidade, novoPasso);
   int *novoPesos = new int[novaCapacidade];
-  int **novaMatriz = new int *[novaCapacidade];
-  for (int i = 0; i < novaCapacidade; i++) {
-    novaMatriz[i] = nullptr;
-  }
-  // Copia os dados dos nós já inseridos
+  int *novoGrauSaida = new int[novaCapacidade];
+  int *novoGrauEntrada = new int[novaCapacidade];
+  REGISTRA_BYTES((long long)novaCapacidade * novoPasso * sizeof(int) +
+                 3LL * novaCapacidade * sizeof(int));
+  // Copia os dados dos nós já inseridos; o restante já está zerado
   for (int i = 0; i < nNos; i++) {
+    const int *orig = linha(i);
+    int *dest = novaMatriz + (size_t)i * novoPasso;
+    for (int j = 0; j < nNos; j++)
+      dest[j] = orig[j];
     novoPesos[i] = pesosVertices[i];
-    // Aloca uma nova linha com novaCapacidade colunas
-    novaMatriz[i] = new int[novaCapacidade];
-    // Copia os valores existentes para as colunas de 0 a nNos-1
-    for (int j = 0; j < nNos; j++) {
-      novaMatriz[i][j] = matriz[i][j];
-    }
-    // Inicializa as colunas restantes com 0
-    for (int j = nNos; j < novaCapacidade; j++) {
-      novaMatriz[i][j] = 0;
-    }
+    novoGrauSaida[i] = grauSaida[i];
+    novoGrauEntrada[i] = grauEntrada[i];
   }
-  // Libera a matriz e o vetor de pesos antigos
-  for (int i = 0; i < nNos; i++) {
-    if (matriz[i] != nullptr) {
-      delete[] matriz[i];
-    }
-  }
-  delete[] matriz;
+  libera_matriz(matriz);
   delete[] pesosVertices;
-  // Atualiza os ponteiros e a capacidade
+  delete[] grauSaida;
+  delete[] grauEntrada;
   matriz = novaMatriz;
+  passo = novoPasso;
   pesosVertices = novoPesos;
+  grauSaida = novoGrauSaida;
+  grauEntrada = novoGrauEntrada;
   capacidade = novaCapacidade;
 }
 
+// A matriz é alocada já com a ordem informada no cabeçalho, sem as cópias
+// das duplicações sucessivas
+void GrafoMatriz::reserva(int nVertices, int nArestas) {
+  (void)nArestas;
+  if (nVertices > capacidade)
+    realocarMatriz(nVertices);
+}
+
+void GrafoMatriz::reduz_capacidade() {
+  garante_compacto();
+  int novaCapacidade = (nNos > 10 ? nNos : 10);
+  if (novaCapacidade < capacidade)
+    realocarMatriz(novaCapacidade);
+}
+
 void GrafoMatriz::novo_no(int peso) {
-  if (nNos >= capacidade) {
-    realocarMatriz(capacidade * 2);
-  }
-  // Aloca a linha para o novo nó se ainda não foi alocada
-  if (matriz[nNos] == nullptr) {
-    matriz[nNos] = new int[capacidade];
-    for (int j = 0; j < capacidade; j++) {
-      matriz[nNos][j] = 0;
-    }
-  }
-  pesosVertices[nNos] = peso;
-  // Inicializa, para cada nó já inserido, a coluna do novo nó com 0
-  for (int i = 0; i < nNos; i++) {
-    matriz[i][nNos] = 0;
-  }
-  nNos++;
-  // Observe: NÃO atualizamos a variável "ordem" aqui,
-  // pois a ordem já foi definida no carregamento do grafo.
+  INSTRUMENTA(OP_NOVO_NO);
+  inserir_vertice(nNos + 1, peso);
+  ordem++;
 }
 
 void GrafoMatriz::nova_aresta(int origem, int destino, int peso) {
+  INSTRUMENTA(OP_NOVA_ARESTA);
+  garante_compacto();
   // Validação para impedir laço e aresta múltipla
   if (origem == destino) {
     cerr << "Erro: Laço não permitido." << endl;
@@ -135,93 +244,142 @@ void GrafoMatriz::nova_aresta(int origem, int destino, int peso) {
     cerr << "Erro: Vértice inexistente." << endl;
     return;
   }
-  if (matriz[o][d] != 0) {
+  if (celula(o, d) != 0) {
     cerr << "Erro: Aresta já existe." << endl;
     return;
   }
-  matriz[o][d] = peso;
+  define_celula(o, d, peso);
+  if (!direcionado)
+    define_celula(d, o, peso);
+  if (peso != 0)
+    registra_aresta(origem, destino, peso);
+}
+
+void GrafoMatriz::altera_peso_aresta(int origem, int destino, int peso) {
+  INSTRUMENTA(OP_ALTERA_PESO_ARESTA);
+  garante_compacto();
+  int o = origem - 1;
+  int d = destino - 1;
+  if (o < 0 || o >= nNos || d < 0 || d >= nNos || celula(o, d) == 0) {
+    cerr << "Erro: Aresta de " << origem << " para " << destino
+         << " não existe." << endl;
+    return;
+  }
+  // Peso 0 representa ausência de aresta
+  if (peso == 0) {
+    cerr << "Erro: Peso 0 não permitido na matriz." << endl;
+    return;
+  }
+  int antigo = celula(o, d);
+  define_celula(o, d, peso);
   if (!direcionado)
-    matriz[d][o] = peso;
+    define_celula(d, o, peso);
+  registra_peso(origem, destino, antigo, peso);
 }
 
+// Remove o nó: as suas arestas são apagadas (zerando a linha e a coluna) e a
+// posição é marcada como removida. Sem o modo de remoção adiada a matriz é
+// compactada em seguida, renumerando os nós remanescentes.
 void GrafoMatriz::deleta_no(int id) {
-  int index = id - 1; // Convertendo para índice 0-based
-  if (index < 0 || index >= nNos) {
+  INSTRUMENTA(OP_DELETA_NO);
+  int pos = (id >= 1 ? posicao_do_id(id) : -1);
+  if (pos < 1 || pos > nNos) {
     cerr << "Erro: Vértice " << id << " não existe." << endl;
     return;
   }
 
-  int newSize = nNos - 1; // Novo número de nós
-
-  // Aloca nova matriz para os nós remanescentes
-  int **novaMatriz = new int *[capacidade]; // mantemos a mesma capacidade
-  for (int i = 0; i < newSize; i++) {
-    novaMatriz[i] = new int[capacidade];
-    // Inicializa as colunas (usaremos apenas 0 até newSize-1; o restante pode
-    // ser 0 também)
-    for (int j = 0; j < capacidade; j++) {
-      novaMatriz[i][j] = 0;
-    }
+  registra_remocao();
+  int index = pos - 1; // Convertendo para índice 0-based
+  for (int j = 0; j < nNos; j++) {
+    if (celula(index, j) != 0)
+      define_celula(index, j, 0);
+    if (celula(j, index) != 0)
+      define_celula(j, index, 0);
   }
+  if (removidosPendentes == 0)
+    posicoesVivas.reinicia(nNos);
+  posicoesVivas.remove(pos);
+  removidosPendentes++;
+  ordem--;
+
+  if (!remocaoAdiada)
+    compacta();
+}
 
-  // Aloca novo vetor de pesos
-  int *novoPesos = new int[capacidade];
+void GrafoMatriz::compacta() {
+  INSTRUMENTA(OP_COMPACTA);
+  if (removidosPendentes == 0)
+    return;
+  int newSize = nNos - removidosPendentes; // Novo número de nós
 
-  // Copia os dados da matriz antiga, pulando a linha e coluna do nó removido
+  // Move as células no próprio bloco, pulando as linhas e colunas removidas
+  // (já zeradas, então os graus dos nós restantes não mudam). O destino
+  // (newRow, newCol) nunca está adiante da origem (i, j), então a cópia em
+  // ordem crescente é segura.
   int newRow = 0;
   for (int i = 0; i < nNos; i++) {
-    if (i == index)
-      continue; // Pula a linha que será removida
+    if (!posicoesVivas.esta_viva(i + 1))
+      continue; // Pula as linhas removidas
+    const int *orig = linha(i);
+    int *dest = linha(newRow);
     int newCol = 0;
     for (int j = 0; j < nNos; j++) {
-      if (j == index)
-        continue; // Pula a coluna que será removida
-      novaMatriz[newRow][newCol] = matriz[i][j];
-      newCol++;
+      if (!posicoesVivas.esta_viva(j + 1))
+        continue; // Pula as colunas removidas
+      dest[newCol++] = orig[j];
     }
-    novoPesos[newRow] = pesosVertices[i];
+    pesosVertices[newRow] = pesosVertices[i];
+    grauSaida[newRow] = grauSaida[i];
+    grauEntrada[newRow] = grauEntrada[i];
     newRow++;
   }
 
-  // Libera a memória da matriz antiga e do vetor de pesos antigo
-  for (int i = 0; i < nNos; i++) {
-    if (matriz[i] != nullptr) {
-      delete[] matriz[i];
-    }
+  // Zera as linhas e colunas que deixaram de ser usadas
+  for (int i = newSize; i < nNos; i++) {
+    int *l = linha(i);
+    for (int j = 0; j < nNos; j++)
+      l[j] = 0;
+  }
+  for (int i = 0; i < newSize; i++) {
+    int *l = linha(i);
+    for (int j = newSize; j < nNos; j++)
+      l[j] = 0;
   }
-  delete[] matriz;
-  delete[] pesosVertices;
 
-  // Atualiza os ponteiros e o contador de nós
-  matriz = novaMatriz;
-  pesosVertices = novoPesos;
   nNos = newSize;
   ordem = newSize; // A ordem passa a ser o novo número de nós
+  removidosPendentes = 0;
 }
 
 void GrafoMatriz::deleta_aresta(int origem, int destino) {
+  INSTRUMENTA(OP_DELETA_ARESTA);
+  garante_compacto();
   int o = origem - 1;
   int d = destino - 1;
   if (o < 0 || o >= nNos || d < 0 || d >= nNos) {
     cerr << "Indices de aresta invalidos." << endl;
     return;
   }
-  matriz[o][d] = 0;
+  registra_remocao();
+  define_celula(o, d, 0);
   if (!direcionado)
-    matriz[d][o] = 0;
+    define_celula(d, o, 0);
 }
 
 double GrafoMatriz::getPesoAresta(int origem, int destino) const {
+  CONTA_CHAMADA(OP_GET_PESO_ARESTA);
+  garante_compacto();
   int o = origem - 1;
   int d = destino - 1;
   if (o < 0 || o >= nNos || d < 0 || d >= nNos)
     return INF;
-  if (matriz[o][d] == 0)
+  if (celula(o, d) == 0)
     return INF;
-  return (double)matriz[o][d];
+  return (double)celula(o, d);
 }
 
 void GrafoMatriz::imprime_grafo() const {
+  garante_compacto();
   std::cout << "Grafo (Matriz de Adjacência):" << std::endl;
   std::cout << "Ordem: " << ordem << std::endl;
   // Itera pelos nós (usando nNos como o número atual de nós inseridos)
@@ -234,10 +392,10 @@ void GrafoMatriz::imprime_grafo() const {
     // Lista os vizinhos e o peso da aresta (se ponderada)
     bool temVizinhos = false;
     for (int j = 0; j < nNos; j++) {
-      if (matriz[i][j] != 0) {
+      if (celula(i, j) != 0) {
         std::cout << (j + 1);
         if (ponderadoArestas)
-          std::cout << " (peso: " << matriz[i][j] << ")";
+          std::cout << " (peso: " << celula(i, j) << ")";
         std::cout << " ";
         temVizinhos = true;
       }
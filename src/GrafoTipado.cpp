@@ -0,0 +1,93 @@
+#include "../include/GrafoTipado.hpp"
+#include "../include/FormatoBinario.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+using namespace std;
+
+static const char *nomesTiposPeso[] = {"auto",  "nenhum", "int8",
+                                       "int16", "int32",  "float"};
+
+bool tipo_peso_por_nome(const string &nome, TipoPesoAresta &tipo) {
+  for (int t = PESO_AUTOMATICO; t <= PESO_FLOAT; t++) {
+    if (nome == nomesTiposPeso[t]) {
+      tipo = (TipoPesoAresta)t;
+      return true;
+    }
+  }
+  return false;
+}
+
+const char *nome_tipo_peso(TipoPesoAresta tipo) {
+  return (tipo >= PESO_AUTOMATICO && tipo <= PESO_FLOAT ? nomesTiposPeso[tipo]
+                                                        : "?");
+}
+
+// Uma instanciação por combinação: a escolha é feita aqui, uma única vez
+template <bool D, bool PV> static Grafo *cria_por_peso(TipoPesoAresta tipo) {
+  switch (tipo) {
+  case PESO_NENHUM:
+    return new GrafoTipado<D, SemPeso, PV>();
+  case PESO_INT8:
+    return new GrafoTipado<D, int8_t, PV>();
+  case PESO_INT16:
+    return new GrafoTipado<D, int16_t, PV>();
+  case PESO_FLOAT:
+    return new GrafoTipado<D, float, PV>();
+  default:
+    return new GrafoTipado<D, int32_t, PV>();
+  }
+}
+
+Grafo *cria_grafo_tipado(bool direcionado, TipoPesoAresta tipo,
+                         bool pesoVertices) {
+  if (direcionado)
+    return (pesoVertices ? cria_por_peso<true, true>(tipo)
+                         : cria_por_peso<true, false>(tipo));
+  return (pesoVertices ? cria_por_peso<false, true>(tipo)
+                       : cria_por_peso<false, false>(tipo));
+}
+
+// Flags do cabeçalho no formato de FormatoBinario.hpp
+static bool le_cabecalho_binario(const string &nomeArquivo, uint32_t &flags) {
+  CabecalhoBinario cabecalho;
+  FILE *arquivo = fopen(nomeArquivo.c_str(), "rb");
+  if (arquivo == nullptr)
+    return false;
+  size_t lidos = fread(&cabecalho, 1, sizeof(cabecalho), arquivo);
+  fclose(arquivo);
+  if (lidos != sizeof(cabecalho) ||
+      cabecalho.marcaOrdemBytes != MARCA_ORDEM_BYTES)
+    return false;
+  flags = cabecalho.flags;
+  return true;
+}
+
+static bool le_cabecalho_texto(const string &nomeArquivo, uint32_t &flags) {
+  ifstream arquivo(nomeArquivo);
+  int cabecalho[4];
+  for (int i = 0; i < 4; i++) {
+    if (!(arquivo >> cabecalho[i]) || cabecalho[i] < 0)
+      return false;
+  }
+  flags = (cabecalho[1] != 0 ? BINARIO_DIRECIONADO : 0) |
+          (cabecalho[2] != 0 ? BINARIO_PONDERADO_VERTICES : 0) |
+          (cabecalho[3] != 0 ? BINARIO_PONDERADO_ARESTAS : 0);
+  return true;
+}
+
+Grafo *cria_grafo_tipado(const string &nomeArquivo, TipoPesoAresta tipo) {
+  uint32_t flags = 0;
+  bool lido = (Grafo::eh_arquivo_binario(nomeArquivo)
+                   ? le_cabecalho_binario(nomeArquivo, flags)
+                   : le_cabecalho_texto(nomeArquivo, flags));
+  if (!lido) {
+    cerr << "Erro: cabeçalho inválido em " << nomeArquivo << ".\n";
+    return nullptr;
+  }
+  if (tipo == PESO_AUTOMATICO)
+    tipo = (flags & BINARIO_PONDERADO_ARESTAS ? PESO_INT32 : PESO_NENHUM);
+  return cria_grafo_tipado((flags & BINARIO_DIRECIONADO) != 0, tipo,
+                           (flags & BINARIO_PONDERADO_VERTICES) != 0);
+}
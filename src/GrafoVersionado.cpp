@@ -0,0 +1,873 @@
+#include "../include/GrafoVersionado.hpp"
+#include <cstring>
+#include <iostream>
+using namespace std;
+
+// Ramos por nó da árvore de posições
+static const int BITS_RAMO = 5;
+static const int RAMOS = 1 << BITS_RAMO;
+static const int MASCARA_RAMO = RAMOS - 1;
+// Peso devolvido por getPesoAresta quando a aresta não existe
+static const double AUSENTE = 1e9;
+
+// Adjacência de uma posição: destinos são posições (não ids). 'geracao'
+// identifica o rascunho que criou a linha, o único que pode alterá-la no
+// lugar; as demais versões que a compartilham a copiam antes de mudar.
+struct LinhaVersao {
+  atomic<int> referencias;
+  uint64_t geracao;
+  int grau;
+  int capacidade;
+  int pesoVertice;
+  int *destinos; // destinos e pesos no mesmo bloco
+  int *pesos;
+};
+
+// Nó da árvore: no nível 0 (folhas) aponta para linhas, nos demais para nós
+// do nível abaixo. O nível de um nó é fixo (contado a partir das folhas), de
+// modo que versões de alturas diferentes compartilham as mesmas subárvores.
+struct NoVersao {
+  atomic<int> referencias;
+  uint64_t geracao;
+  union {
+    NoVersao *filhos[RAMOS];
+    LinhaVersao *linhas[RAMOS];
+  };
+};
+
+// Posições removidas, em ordem crescente (as posições não são reutilizadas).
+// Compartilhada entre as versões até a próxima remoção, como as linhas.
+struct RemovidasVersao {
+  atomic<int> referencias;
+  uint64_t geracao;
+  int quantidade;
+  int capacidade;
+  int *posicoes;
+};
+
+struct VersaoGrafo {
+  long long numero;
+  uint64_t geracao;
+  bool alterada; // o rascunho mudou em relação à versão de origem
+  bool direcionado;
+  bool ponderadoVertices;
+  bool ponderadoArestas;
+  int altura;    // níveis da árvore: posições < RAMOS^altura
+  int nPosicoes; // posições já usadas, inclusive as removidas
+  int ordem;     // posições vivas
+  long long nArestas;
+  NoVersao *saidas;
+  NoVersao *entradas; // predecessores (só em grafos direcionados)
+  // nPosicoes - ordem posições; nullptr enquanto nenhuma foi removida
+  RemovidasVersao *removidas;
+};
+
+// Gerações dos rascunhos, únicas no processo
+static atomic<uint64_t> proximaGeracao(1);
+
+static LinhaVersao *nova_linha(int capacidade, uint64_t geracao,
+                               int pesoVertice) {
+  LinhaVersao *l = new LinhaVersao;
+  l->referencias.store(1, memory_order_relaxed);
+  l->geracao = geracao;
+  l->grau = 0;
+  l->capacidade = capacidade;
+  l->pesoVertice = pesoVertice;
+  l->destinos = (capacidade > 0 ? new int[2 * capacidade] : nullptr);
+  l->pesos = l->destinos + capacidade;
+  REGISTRA_BYTES((long long)sizeof(LinhaVersao) +
+                 2 * sizeof(int) * capacidade);
+  return l;
+}
+
+static LinhaVersao *copia_linha(const LinhaVersao *l, int capacidade,
+                                uint64_t geracao) {
+  if (capacidade < l->grau)
+    capacidade = l->grau;
+  LinhaVersao *c = nova_linha(capacidade, geracao, l->pesoVertice);
+  c->grau = l->grau;
+  if (l->grau > 0) {
+    memcpy(c->destinos, l->destinos, l->grau * sizeof(int));
+    memcpy(c->pesos, l->pesos, l->grau * sizeof(int));
+  }
+  return c;
+}
+
+static void solta_linha(LinhaVersao *l) {
+  if (l == nullptr || l->referencias.fetch_sub(1, memory_order_acq_rel) != 1)
+    return;
+  delete[] l->destinos;
+  delete l;
+}
+
+static NoVersao *novo_no_arvore(uint64_t geracao) {
+  REGISTRA_BYTES(sizeof(NoVersao));
+  NoVersao *no = new NoVersao;
+  no->referencias.store(1, memory_order_relaxed);
+  no->geracao = geracao;
+  for (int i = 0; i < RAMOS; i++)
+    no->filhos[i] = nullptr;
+  return no;
+}
+
+static void retem_no(NoVersao *no) {
+  if (no != nullptr)
+    no->referencias.fetch_add(1, memory_order_relaxed);
+}
+
+// Libera a referência; o nó (e o que só ele referencia) é apagado na última
+static void solta_no(NoVersao *no, int nivel) {
+  if (no == nullptr || no->referencias.fetch_sub(1, memory_order_acq_rel) != 1)
+    return;
+  for (int i = 0; i < RAMOS; i++) {
+    if (nivel > 0)
+      solta_no(no->filhos[i], nivel - 1);
+    else
+      solta_linha(no->linhas[i]);
+  }
+  delete no;
+}
+
+static NoVersao *copia_no(const NoVersao *no, int nivel, uint64_t geracao) {
+  NoVersao *c = novo_no_arvore(geracao);
+  for (int i = 0; i < RAMOS; i++) {
+    if (nivel > 0) {
+      c->filhos[i] = no->filhos[i];
+      retem_no(c->filhos[i]);
+    } else {
+      c->linhas[i] = no->linhas[i];
+      if (c->linhas[i] != nullptr)
+        c->linhas[i]->referencias.fetch_add(1, memory_order_relaxed);
+    }
+  }
+  return c;
+}
+
+static const LinhaVersao *linha_de(const NoVersao *raiz, int altura, int p) {
+  const NoVersao *no = raiz;
+  for (int nivel = altura - 1; nivel > 0 && no != nullptr; nivel--)
+    no = no->filhos[(p >> (nivel * BITS_RAMO)) & MASCARA_RAMO];
+  return (no != nullptr ? no->linhas[p & MASCARA_RAMO] : nullptr);
+}
+
+static void solta_removidas(RemovidasVersao *r) {
+  if (r == nullptr || r->referencias.fetch_sub(1, memory_order_acq_rel) != 1)
+    return;
+  delete[] r->posicoes;
+  delete r;
+}
+
+static void libera_versao(VersaoGrafo *v) {
+  if (v == nullptr)
+    return;
+  solta_no(v->saidas, v->altura - 1);
+  solta_no(v->entradas, v->altura - 1);
+  solta_removidas(v->removidas);
+  delete v;
+}
+
+// Versão nova (com geração própria) que compartilha as raízes e as posições
+// removidas de 'base'
+static VersaoGrafo *deriva_versao(const VersaoGrafo *base, long long numero) {
+  VersaoGrafo *v = new VersaoGrafo;
+  v->numero = numero;
+  v->geracao = proximaGeracao.fetch_add(1);
+  v->alterada = false;
+  v->direcionado = base->direcionado;
+  v->ponderadoVertices = base->ponderadoVertices;
+  v->ponderadoArestas = base->ponderadoArestas;
+  v->altura = base->altura;
+  v->nPosicoes = base->nPosicoes;
+  v->ordem = base->ordem;
+  v->nArestas = base->nArestas;
+  v->saidas = base->saidas;
+  v->entradas = base->entradas;
+  v->removidas = base->removidas;
+  retem_no(v->saidas);
+  retem_no(v->entradas);
+  if (v->removidas != nullptr)
+    v->removidas->referencias.fetch_add(1, memory_order_relaxed);
+  return v;
+}
+
+// Ponteiro para a linha da posição p no rascunho v, copiando os nós
+// compartilhados do caminho e criando os ausentes
+static LinhaVersao **entrada(VersaoGrafo *v, NoVersao **raiz, int p) {
+  v->alterada = true;
+  NoVersao **ref = raiz;
+  for (int nivel = v->altura - 1;; nivel--) {
+    NoVersao *no = *ref;
+    if (no == nullptr) {
+      no = *ref = novo_no_arvore(v->geracao);
+    } else if (no->geracao != v->geracao) {
+      NoVersao *copia = copia_no(no, nivel, v->geracao);
+      solta_no(no, nivel);
+      no = *ref = copia;
+    }
+    if (nivel == 0)
+      return &no->linhas[p & MASCARA_RAMO];
+    ref = &no->filhos[(p >> (nivel * BITS_RAMO)) & MASCARA_RAMO];
+  }
+}
+
+// Linha da posição p que o rascunho pode alterar no lugar (uma cópia, se
+// ela for compartilhada, com espaço para mais 'folga' arestas)
+static LinhaVersao *linha_propria(VersaoGrafo *v, NoVersao **raiz, int p,
+                                  int folga) {
+  LinhaVersao **ref = entrada(v, raiz, p);
+  LinhaVersao *l = *ref;
+  if (l->geracao != v->geracao) {
+    LinhaVersao *copia = copia_linha(l, l->grau + folga, v->geracao);
+    solta_linha(l);
+    l = *ref = copia;
+  }
+  return l;
+}
+
+// Acrescenta uma camada acima das raízes até caberem n posições
+static void garante_altura(VersaoGrafo *v, int n) {
+  while ((1LL << (BITS_RAMO * v->altura)) < n) {
+    NoVersao **raizes[2] = {&v->saidas, &v->entradas};
+    for (int r = 0; r < 2; r++) {
+      if (*raizes[r] == nullptr)
+        continue;
+      NoVersao *topo = novo_no_arvore(v->geracao);
+      topo->filhos[0] = *raizes[r];
+      *raizes[r] = topo;
+    }
+    v->altura++;
+    v->alterada = true;
+  }
+}
+
+static int busca(const LinhaVersao *l, int destino) {
+  for (int i = 0; i < l->grau; i++) {
+    if (l->destinos[i] == destino)
+      return i;
+  }
+  return -1;
+}
+
+static void adiciona(LinhaVersao *l, int destino, int peso) {
+  if (l->grau == l->capacidade) {
+    int capacidade = (l->capacidade < 2 ? 4 : 2 * l->capacidade);
+    REGISTRA_BYTES(2 * sizeof(int) * (long long)(capacidade - l->capacidade));
+    int *dados = new int[2 * capacidade];
+    if (l->grau > 0) {
+      memcpy(dados, l->destinos, l->grau * sizeof(int));
+      memcpy(dados + capacidade, l->pesos, l->grau * sizeof(int));
+    }
+    delete[] l->destinos;
+    l->destinos = dados;
+    l->pesos = dados + capacidade;
+    l->capacidade = capacidade;
+  }
+  l->destinos[l->grau] = destino;
+  l->pesos[l->grau] = peso;
+  l->grau++;
+}
+
+// Remove o i-ésimo destino preservando a ordem dos demais
+static void remove_em(LinhaVersao *l, int i) {
+  for (int j = i + 1; j < l->grau; j++) {
+    l->destinos[j - 1] = l->destinos[j];
+    l->pesos[j - 1] = l->pesos[j];
+  }
+  l->grau--;
+}
+
+// Marca a posição p (viva) como removida no rascunho v
+static void marca_removida(VersaoGrafo *v, int p) {
+  RemovidasVersao *r = v->removidas;
+  if (r == nullptr || r->geracao != v->geracao) {
+    int quantidade = (r != nullptr ? r->quantidade : 0);
+    RemovidasVersao *copia = new RemovidasVersao;
+    copia->referencias.store(1, memory_order_relaxed);
+    copia->geracao = v->geracao;
+    copia->quantidade = quantidade;
+    copia->capacidade = (quantidade < 4 ? 8 : 2 * quantidade);
+    copia->posicoes = new int[copia->capacidade];
+    REGISTRA_BYTES((long long)sizeof(RemovidasVersao) +
+                   sizeof(int) * copia->capacidade);
+    if (quantidade > 0)
+      memcpy(copia->posicoes, r->posicoes, quantidade * sizeof(int));
+    solta_removidas(r);
+    r = v->removidas = copia;
+  } else if (r->quantidade == r->capacidade) {
+    REGISTRA_BYTES(sizeof(int) * (long long)r->capacidade);
+    int *posicoes = new int[2 * r->capacidade];
+    memcpy(posicoes, r->posicoes, r->quantidade * sizeof(int));
+    delete[] r->posicoes;
+    r->posicoes = posicoes;
+    r->capacidade *= 2;
+  }
+  int i = r->quantidade;
+  while (i > 0 && r->posicoes[i - 1] > p) {
+    r->posicoes[i] = r->posicoes[i - 1];
+    i--;
+  }
+  r->posicoes[i] = p;
+  r->quantidade++;
+}
+
+// Posição do vértice 'id' (1-based), -1 se não existir. Antes da i-ésima
+// posição removida há posicoes[i] - i posições vivas, então o vértice fica
+// id - 1 posições adiante, mais uma para cada removida com no máximo id - 1
+// vivas antes dela.
+static int posicao_na_versao(const VersaoGrafo *v, int id) {
+  if (id < 1 || id > v->ordem)
+    return -1;
+  const RemovidasVersao *r = v->removidas;
+  if (r == nullptr)
+    return id - 1;
+  int inicio = 0, fim = r->quantidade;
+  while (inicio < fim) {
+    int meio = (inicio + fim) / 2;
+    if (r->posicoes[meio] - meio <= id - 1)
+      inicio = meio + 1;
+    else
+      fim = meio;
+  }
+  return id - 1 + inicio;
+}
+
+// Id da posição viva p: p + 1 menos as removidas antes dela
+static int id_na_versao(const VersaoGrafo *v, int p) {
+  const RemovidasVersao *r = v->removidas;
+  if (r == nullptr)
+    return p + 1;
+  int inicio = 0, fim = r->quantidade;
+  while (inicio < fim) {
+    int meio = (inicio + fim) / 2;
+    if (r->posicoes[meio] < p)
+      inicio = meio + 1;
+    else
+      fim = meio;
+  }
+  return p + 1 - inicio;
+}
+
+// --- Consultas ---
+
+long long VisaoVersao::get_numero_versao() const { return versao->numero; }
+
+// Os destinos são visitados do último inserido para o primeiro, como na
+// GrafoLista
+static void percorre_linha(const VersaoGrafo *v, const NoVersao *raiz,
+                           int vertice, VisitanteVizinhos &visitante) {
+  int p = posicao_na_versao(v, vertice);
+  if (p < 0)
+    return;
+  const LinhaVersao *l = linha_de(raiz, v->altura, p);
+  for (int i = l->grau - 1; i >= 0; i--) {
+    if (!visitante.visita(id_na_versao(v, l->destinos[i]), l->pesos[i]))
+      return;
+  }
+}
+
+void VisaoVersao::percorre_vizinhos(int vertice,
+                                    VisitanteVizinhos &visitante) const {
+  percorre_linha(versao, versao->saidas, vertice, visitante);
+}
+
+int VisaoVersao::get_grau_saida(int vertice) const {
+  int p = posicao_na_versao(versao, vertice);
+  return (p < 0 ? 0 : linha_de(versao->saidas, versao->altura, p)->grau);
+}
+
+int VisaoVersao::get_num_arestas() const { return (int)versao->nArestas; }
+
+int VisaoVersao::get_grau_entrada(int vertice) const {
+  if (!versao->direcionado)
+    return get_grau_saida(vertice);
+  int p = posicao_na_versao(versao, vertice);
+  return (p < 0 ? 0 : linha_de(versao->entradas, versao->altura, p)->grau);
+}
+
+void VisaoVersao::percorre_predecessores(int vertice,
+                                         VisitanteVizinhos &visitante) const {
+  if (!versao->direcionado)
+    percorre_vizinhos(vertice, visitante);
+  else
+    percorre_linha(versao, versao->entradas, vertice, visitante);
+}
+
+int VisaoVersao::get_peso_vertice(int vertice) const {
+  int p = posicao_na_versao(versao, vertice);
+  return (p < 0 ? 0 : linha_de(versao->saidas, versao->altura, p)->pesoVertice);
+}
+
+double VisaoVersao::getPesoAresta(int origem, int destino) const {
+  CONTA_CHAMADA(OP_GET_PESO_ARESTA);
+  int po = posicao_na_versao(versao, origem);
+  int pd = posicao_na_versao(versao, destino);
+  if (po < 0 || pd < 0)
+    return AUSENTE;
+  const LinhaVersao *l = linha_de(versao->saidas, versao->altura, po);
+  int i = busca(l, pd);
+  return (i < 0 ? AUSENTE : l->pesos[i]);
+}
+
+void VisaoVersao::imprime_grafo() const {
+  std::cout << "Grafo (Versionado, "
+            << (versao->direcionado ? "direcionado" : "não direcionado")
+            << ", versão " << versao->numero << "):" << std::endl;
+  std::cout << "Ordem: " << versao->ordem << std::endl;
+  for (int v = 1; v <= versao->ordem; v++) {
+    std::cout << "Vértice " << v;
+    if (versao->ponderadoVertices)
+      std::cout << " (peso: " << get_peso_vertice(v) << ")";
+    std::cout << " -> ";
+    if (get_grau_saida(v) == 0)
+      std::cout << "Sem vizinhos";
+    para_cada_vizinho(v, [](int w, int) {
+      std::cout << w << " ";
+      return true;
+    });
+    std::cout << std::endl;
+  }
+}
+
+// --- Versões ---
+
+GrafoVersionado::GrafoVersionado()
+    : rascunho(nullptr), carregando(false), retiradas(nullptr),
+      epocasRetirada(nullptr), nRetiradas(0), capRetiradas(0) {
+  VersaoGrafo *v = new VersaoGrafo;
+  v->numero = 0;
+  v->geracao = proximaGeracao.fetch_add(1);
+  v->alterada = false;
+  v->direcionado = direcionado;
+  v->ponderadoVertices = ponderadoVertices;
+  v->ponderadoArestas = ponderadoArestas;
+  v->altura = 1;
+  v->nPosicoes = 0;
+  v->ordem = 0;
+  v->nArestas = 0;
+  v->saidas = nullptr;
+  v->entradas = nullptr;
+  v->removidas = nullptr;
+  publicada.store(v);
+  versao = v;
+}
+
+GrafoVersionado::GrafoVersionado(const VersaoGrafo *base)
+    : rascunho(nullptr), carregando(false), retiradas(nullptr),
+      epocasRetirada(nullptr), nRetiradas(0), capRetiradas(0) {
+  INSTRUMENTA(OP_CLONA);
+  VersaoGrafo *v = deriva_versao(base, base->numero);
+  ordem = v->ordem;
+  direcionado = v->direcionado;
+  ponderadoVertices = v->ponderadoVertices;
+  ponderadoArestas = v->ponderadoArestas;
+  componentesValidas = false;
+  publicada.store(v);
+  versao = v;
+}
+
+GrafoVersionado::GrafoVersionado(const Grafo &origem) : GrafoVersionado() {
+  direcionado = origem.eh_direcionado();
+  ponderadoVertices = origem.vertice_ponderado();
+  ponderadoArestas = origem.aresta_ponderada();
+  int n = origem.get_ordem();
+  reserva(n, origem.get_num_arestas());
+  for (int v = 1; v <= n; v++)
+    inserir_vertice(v, origem.get_peso_vertice(v));
+  ordem = n;
+  for (int v = 1; v <= n; v++) {
+    origem.para_cada_vizinho(v, [this, v](int w, int peso) {
+      // Em grafos não direcionados a inserção cria as duas cópias
+      if (direcionado || w > v)
+        insere(v, w, peso, true);
+      return true;
+    });
+  }
+  fim_carga();
+}
+
+// As cópias começam sem as componentes e as distâncias calculadas, mas com a
+// mesma configuração do cálculo de distâncias
+GrafoVersionado *GrafoVersionado::clona() const {
+  GrafoVersionado *copia = new GrafoVersionado(publicada.load());
+  copia->modoDistancia = modoDistancia;
+  copia->varredurasDiametro = varredurasDiametro;
+  return copia;
+}
+
+// Os instantâneos já devem ter sido destruídos
+GrafoVersionado::~GrafoVersionado() {
+  libera_versao(rascunho);
+  libera_versao(publicada.load());
+  for (int i = 0; i < nRetiradas; i++)
+    libera_versao(retiradas[i]);
+  delete[] retiradas;
+  delete[] epocasRetirada;
+}
+
+// O rascunho começa compartilhando as raízes da versão publicada; a direção
+// e os pesos são os do objeto no momento da abertura (a carga os define antes
+// de reserva)
+VersaoGrafo *GrafoVersionado::abre_rascunho() {
+  if (rascunho != nullptr)
+    return rascunho;
+  const VersaoGrafo *base = publicada.load(memory_order_relaxed);
+  VersaoGrafo *r = deriva_versao(base, base->numero + 1);
+  r->direcionado = direcionado;
+  r->ponderadoVertices = ponderadoVertices;
+  r->ponderadoArestas = ponderadoArestas;
+  rascunho = r;
+  versao = r;
+  return r;
+}
+
+void GrafoVersionado::conclui() {
+  if (carregando || rascunho == nullptr)
+    return;
+  if (rascunho->alterada) {
+    publica();
+    return;
+  }
+  libera_versao(rascunho);
+  rascunho = nullptr;
+  versao = publicada.load(memory_order_relaxed);
+}
+
+// A troca do ponteiro é o ponto de publicação; a versão anterior fica
+// retida até que os leitores que entraram antes da troca saiam
+void GrafoVersionado::publica() {
+  INSTRUMENTA(OP_PUBLICA_VERSAO);
+  VersaoGrafo *antiga = publicada.load(memory_order_relaxed);
+  publicada.store(rascunho);
+  versao = rascunho;
+  rascunho = nullptr;
+  retira(antiga, GerenciadorEpocas::global().avanca());
+  recupera();
+}
+
+void GrafoVersionado::retira(VersaoGrafo *v, uint64_t epoca) {
+  if (nRetiradas == capRetiradas) {
+    int capacidade = (capRetiradas == 0 ? 16 : 2 * capRetiradas);
+    VersaoGrafo **versoes = new VersaoGrafo *[capacidade];
+    uint64_t *epocas = new uint64_t[capacidade];
+    for (int i = 0; i < nRetiradas; i++) {
+      versoes[i] = retiradas[i];
+      epocas[i] = epocasRetirada[i];
+    }
+    delete[] retiradas;
+    delete[] epocasRetirada;
+    retiradas = versoes;
+    epocasRetirada = epocas;
+    capRetiradas = capacidade;
+  }
+  retiradas[nRetiradas] = v;
+  epocasRetirada[nRetiradas] = epoca;
+  nRetiradas++;
+}
+
+// As épocas de retirada são crescentes, então as liberáveis formam um prefixo
+void GrafoVersionado::recupera() {
+  if (nRetiradas == 0)
+    return;
+  uint64_t menor = GerenciadorEpocas::global().menor_ativa();
+  int k = 0;
+  while (k < nRetiradas && epocasRetirada[k] < menor)
+    libera_versao(retiradas[k++]);
+  for (int i = k; i < nRetiradas; i++) {
+    retiradas[i - k] = retiradas[i];
+    epocasRetirada[i - k] = epocasRetirada[i];
+  }
+  nRetiradas -= k;
+}
+
+// --- Alterações ---
+
+bool GrafoVersionado::insere(int origem, int destino, int peso, bool carga) {
+  VersaoGrafo *r = abre_rascunho();
+  if (origem == destino) {
+    if (!carga)
+      cerr << "Erro: Laço não permitido." << endl;
+    else if (reporta_recusa())
+      cerr << "Erro: Laço não permitido (origem e destino iguais: " << origem
+           << ")." << endl;
+    return false;
+  }
+  int po = posicao_na_versao(r, origem);
+  int pd = posicao_na_versao(r, destino);
+  if (po < 0 || pd < 0) {
+    if (!carga || reporta_recusa())
+      cerr << "Erro: Vértice " << (po < 0 ? origem : destino)
+           << " não encontrado." << endl;
+    return false;
+  }
+  if (busca(linha_de(r->saidas, r->altura, po), pd) >= 0) {
+    if (!carga || reporta_recusa())
+      cerr << "Erro: Aresta de " << origem << " para " << destino
+           << " já existe." << endl;
+    return false;
+  }
+  adiciona(linha_propria(r, &r->saidas, po, 1), pd, peso);
+  NoVersao **copia = (r->direcionado ? &r->entradas : &r->saidas);
+  adiciona(linha_propria(r, copia, pd, 1), po, peso);
+  r->nArestas++;
+  registra_aresta(origem, destino, peso);
+  return true;
+}
+
+bool GrafoVersionado::remove_aresta(int origem, int destino) {
+  VersaoGrafo *r = abre_rascunho();
+  int po = posicao_na_versao(r, origem);
+  if (po < 0) {
+    cerr << "Erro: Vértice " << origem << " não encontrado." << endl;
+    return false;
+  }
+  int pd = posicao_na_versao(r, destino);
+  int i = (pd < 0 ? -1 : busca(linha_de(r->saidas, r->altura, po), pd));
+  if (i < 0)
+    return false;
+  remove_em(linha_propria(r, &r->saidas, po, 0), i);
+  LinhaVersao *copia =
+      linha_propria(r, r->direcionado ? &r->entradas : &r->saidas, pd, 0);
+  remove_em(copia, busca(copia, po));
+  r->nArestas--;
+  return true;
+}
+
+// Só as linhas dos vizinhos (e, em grafos direcionados, dos predecessores)
+// são copiadas; as posições dos demais vértices não mudam
+void GrafoVersionado::remove_posicao(int p) {
+  VersaoGrafo *r = rascunho;
+  const LinhaVersao *saida = linha_de(r->saidas, r->altura, p);
+  NoVersao **copias = (r->direcionado ? &r->entradas : &r->saidas);
+  for (int i = 0; i < saida->grau; i++) {
+    LinhaVersao *l = linha_propria(r, copias, saida->destinos[i], 0);
+    remove_em(l, busca(l, p));
+  }
+  r->nArestas -= saida->grau;
+  if (r->direcionado) {
+    const LinhaVersao *chegada = linha_de(r->entradas, r->altura, p);
+    for (int i = 0; i < chegada->grau; i++) {
+      LinhaVersao *l = linha_propria(r, &r->saidas, chegada->destinos[i], 0);
+      remove_em(l, busca(l, p));
+    }
+    r->nArestas -= chegada->grau;
+    LinhaVersao **ref = entrada(r, &r->entradas, p);
+    solta_linha(*ref);
+    *ref = nullptr;
+  }
+  LinhaVersao **ref = entrada(r, &r->saidas, p);
+  solta_linha(*ref);
+  *ref = nullptr;
+  marca_removida(r, p);
+  r->ordem--;
+}
+
+// O id é ignorado: o vértice recebe a próxima posição (id ordem + 1)
+void GrafoVersionado::inserir_vertice(int id, int peso) {
+  INSTRUMENTA(OP_INSERIR_VERTICE);
+  (void)id;
+  VersaoGrafo *r = abre_rascunho();
+  int p = r->nPosicoes;
+  garante_altura(r, p + 1);
+  *entrada(r, &r->saidas, p) = nova_linha(0, r->geracao, peso);
+  if (r->direcionado)
+    *entrada(r, &r->entradas, p) = nova_linha(0, r->geracao, 0);
+  r->nPosicoes++;
+  r->ordem++;
+  registra_vertice();
+  conclui();
+}
+
+void GrafoVersionado::inserir_aresta(int origem, int destino, int peso) {
+  INSTRUMENTA(OP_INSERIR_ARESTA);
+  insere(origem, destino, peso, true);
+  conclui();
+}
+
+// Uma única versão para o lote inteiro
+void GrafoVersionado::inserir_arestas_lote(const int *origens,
+                                           const int *destinos,
+                                           const int *pesos, int n) {
+  INSTRUMENTA(OP_INSERIR_ARESTAS_LOTE);
+  for (int i = 0; i < n; i++)
+    insere(origens[i], destinos[i], pesos[i], true);
+  conclui();
+}
+
+void GrafoVersionado::reserva(int nVertices, int nArestas) {
+  (void)nArestas;
+  carregando = true;
+  garante_altura(abre_rascunho(), nVertices);
+}
+
+void GrafoVersionado::fim_carga() {
+  carregando = false;
+  conclui();
+}
+
+void GrafoVersionado::novo_no(int peso) {
+  INSTRUMENTA(OP_NOVO_NO);
+  inserir_vertice(ordem + 1, peso);
+  ordem++;
+}
+
+void GrafoVersionado::nova_aresta(int origem, int destino, int peso) {
+  INSTRUMENTA(OP_NOVA_ARESTA);
+  insere(origem, destino, peso, false);
+  conclui();
+}
+
+void GrafoVersionado::altera_peso_aresta(int origem, int destino, int peso) {
+  INSTRUMENTA(OP_ALTERA_PESO_ARESTA);
+  VersaoGrafo *r = abre_rascunho();
+  int po = posicao_na_versao(r, origem);
+  int pd = posicao_na_versao(r, destino);
+  int i = (po < 0 || pd < 0 ? -1
+                            : busca(linha_de(r->saidas, r->altura, po), pd));
+  if (i < 0) {
+    cerr << "Erro: Aresta de " << origem << " para " << destino
+         << " não existe." << endl;
+    conclui();
+    return;
+  }
+  LinhaVersao *l = linha_propria(r, &r->saidas, po, 0);
+  int antigo = l->pesos[i];
+  l->pesos[i] = peso;
+  // A cópia da aresta no destino: a reversa ou a entrada dos predecessores
+  l = linha_propria(r, r->direcionado ? &r->entradas : &r->saidas, pd, 0);
+  l->pesos[busca(l, po)] = peso;
+  registra_peso(origem, destino, antigo, peso);
+  conclui();
+}
+
+void GrafoVersionado::deleta_no(int id) {
+  INSTRUMENTA(OP_DELETA_NO);
+  VersaoGrafo *r = abre_rascunho();
+  int p = posicao_na_versao(r, id);
+  if (p < 0) {
+    cerr << "Erro: Vértice " << id << " não existe." << endl;
+  } else {
+    remove_posicao(p);
+    registra_remocao();
+    ordem = r->ordem;
+  }
+  conclui();
+}
+
+void GrafoVersionado::deleta_aresta(int origem, int destino) {
+  INSTRUMENTA(OP_DELETA_ARESTA);
+  if (remove_aresta(origem, destino))
+    registra_remocao();
+  conclui();
+}
+
+// As posições são todas calculadas antes da primeira remoção, já que cada
+// remoção muda a correspondência entre ids e posições
+void GrafoVersionado::deleta_nos(const int *ids, int k) {
+  INSTRUMENTA(OP_DELETA_NOS);
+  VersaoGrafo *r = abre_rascunho();
+  int n = r->ordem;
+  bool *removido = new bool[n > 0 ? n : 1];
+  int total = marca_remocoes(ids, k, n, removido);
+  if (total > 0) {
+    int *posicoes = new int[total];
+    int j = 0;
+    for (int v = 0; v < n; v++) {
+      if (removido[v])
+        posicoes[j++] = posicao_na_versao(r, v + 1);
+    }
+    for (int i = 0; i < total; i++)
+      remove_posicao(posicoes[i]);
+    delete[] posicoes;
+    registra_remocao();
+    ordem = r->ordem;
+  }
+  delete[] removido;
+  conclui();
+}
+
+void GrafoVersionado::deleta_arestas(const int *origens, const int *destinos,
+                                     int n) {
+  INSTRUMENTA(OP_DELETA_ARESTAS);
+  bool removida = false;
+  for (int i = 0; i < n; i++)
+    removida = remove_aresta(origens[i], destinos[i]) || removida;
+  if (removida)
+    registra_remocao();
+  conclui();
+}
+
+// --- Instantâneos ---
+
+InstantaneoGrafo::InstantaneoGrafo(const GrafoVersionado &grafo)
+    : vaga(GerenciadorEpocas::global().entra()) {
+  versao = grafo.publicada.load();
+  ordem = versao->ordem;
+  direcionado = versao->direcionado;
+  ponderadoVertices = versao->ponderadoVertices;
+  ponderadoArestas = versao->ponderadoArestas;
+  componentesValidas = false;
+  modoDistancia = grafo.modoDistancia;
+  varredurasDiametro = grafo.varredurasDiametro;
+}
+
+InstantaneoGrafo::~InstantaneoGrafo() {
+  GerenciadorEpocas::global().sai(vaga);
+}
+
+// A versão do instantâneo está retida enquanto ele existir, então as suas
+// partes podem ganhar novas referências
+GrafoVersionado *InstantaneoGrafo::clona() const {
+  GrafoVersionado *copia = new GrafoVersionado(versao);
+  copia->modoDistancia = modoDistancia;
+  copia->varredurasDiametro = varredurasDiametro;
+  return copia;
+}
+
+void InstantaneoGrafo::recusa() const {
+  cerr << "Erro: instantâneo somente leitura; as alterações devem ser feitas "
+          "na GrafoVersionado."
+       << endl;
+}
+
+void InstantaneoGrafo::inserir_vertice(int id, int peso) {
+  (void)id;
+  (void)peso;
+  recusa();
+}
+
+void InstantaneoGrafo::inserir_aresta(int origem, int destino, int peso) {
+  (void)origem;
+  (void)destino;
+  (void)peso;
+  recusa();
+}
+
+void InstantaneoGrafo::novo_no(int peso) {
+  (void)peso;
+  recusa();
+}
+
+void InstantaneoGrafo::nova_aresta(int origem, int destino, int peso) {
+  (void)origem;
+  (void)destino;
+  (void)peso;
+  recusa();
+}
+
+void InstantaneoGrafo::altera_peso_aresta(int origem, int destino, int peso) {
+  (void)origem;
+  (void)destino;
+  (void)peso;
+  recusa();
+}
+
+void InstantaneoGrafo::deleta_no(int id) {
+  (void)id;
+  recusa();
+}
+
+void InstantaneoGrafo::deleta_aresta(int origem, int destino) {
+  (void)origem;
+  (void)destino;
+  recusa();
+}
@@ -0,0 +1,82 @@
+#include "../include/HeapBinario.hpp"
+
+HeapBinario::HeapBinario(int capacidade)
+    : heap(nullptr), posicao(nullptr), prioridade(nullptr), n(0),
+      capacidade(capacidade) {
+  heap = new int[capacidade > 0 ? capacidade : 1];
+  posicao = new int[capacidade > 0 ? capacidade : 1];
+  prioridade = new double[capacidade > 0 ? capacidade : 1];
+  for (int i = 0; i < capacidade; i++)
+    posicao[i] = -1;
+}
+
+HeapBinario::~HeapBinario() {
+  delete[] heap;
+  delete[] posicao;
+  delete[] prioridade;
+}
+
+void HeapBinario::troca(int i, int j) {
+  int a = heap[i];
+  heap[i] = heap[j];
+  heap[j] = a;
+  posicao[heap[i]] = i;
+  posicao[heap[j]] = j;
+}
+
+void HeapBinario::sobe(int i) {
+  while (i > 0) {
+    int pai = (i - 1) / 2;
+    if (prioridade[heap[pai]] <= prioridade[heap[i]])
+      break;
+    troca(i, pai);
+    i = pai;
+  }
+}
+
+void HeapBinario::desce(int i) {
+  for (;;) {
+    int menor = i;
+    int esq = 2 * i + 1;
+    int dir = esq + 1;
+    if (esq < n && prioridade[heap[esq]] < prioridade[heap[menor]])
+      menor = esq;
+    if (dir < n && prioridade[heap[dir]] < prioridade[heap[menor]])
+      menor = dir;
+    if (menor == i)
+      return;
+    troca(i, menor);
+    i = menor;
+  }
+}
+
+void HeapBinario::insere_ou_diminui(int elemento, double novaPrioridade) {
+  if (posicao[elemento] < 0) {
+    heap[n] = elemento;
+    posicao[elemento] = n;
+    prioridade[elemento] = novaPrioridade;
+    n++;
+    sobe(n - 1);
+  } else if (novaPrioridade < prioridade[elemento]) {
+    prioridade[elemento] = novaPrioridade;
+    sobe(posicao[elemento]);
+  }
+}
+
+int HeapBinario::remove_min() {
+  int minimo = heap[0];
+  n--;
+  if (n > 0) {
+    heap[0] = heap[n];
+    posicao[heap[0]] = 0;
+    desce(0);
+  }
+  posicao[minimo] = -1;
+  return minimo;
+}
+
+void HeapBinario::limpa() {
+  for (int i = 0; i < n; i++)
+    posicao[heap[i]] = -1;
+  n = 0;
+}
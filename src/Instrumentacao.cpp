@@ -0,0 +1,141 @@
+#include "../include/Instrumentacao.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <ostream>
+using namespace std;
+
+static const char *nomesOperacoes[N_OPERACOES_INSTRUMENTADAS] = {
+    "carrega_grafo",
+    "carrega_binario",
+    "carrega_fluxo",
+    "get_grau",
+    "n_conexo",
+    "eh_completo",
+    "get_vizinhos",
+    "getPesoAresta",
+    "inserir_vertice",
+    "inserir_aresta",
+    "inserir_arestas_lote",
+    "novo_no",
+    "nova_aresta",
+    "altera_peso_aresta",
+    "deleta_no",
+    "deleta_aresta",
+    "deleta_nos",
+    "deleta_arestas",
+    "compacta",
+    "calculaMaiorMenorDistancia",
+    "encontrar_vertice",
+    "floyd_warshall",
+    "IntList::resize",
+    "realocarMatriz",
+    "no_lista",
+    "bloco_arena",
+    "migra_representacao",
+    "publica_versao",
+    "clona"};
+
+#ifdef GRAFOS_INSTRUMENTACAO
+// Incrementos relaxados: a carga paralela e o Floyd–Warshall blocado chamam
+// operações instrumentadas de várias threads
+static atomic<long long> chamadas[N_OPERACOES_INSTRUMENTADAS];
+static atomic<long long> nanossegundos[N_OPERACOES_INSTRUMENTADAS];
+static atomic<long long> bytes[N_OPERACOES_INSTRUMENTADAS];
+// Bytes alocados pela thread nos pontos instrumentados (ver MedidorOperacao)
+static thread_local long long bytesDaThread = 0;
+#endif
+
+long long Instrumentacao::agora_ns() {
+  return chrono::duration_cast<chrono::nanoseconds>(
+             chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+#ifdef GRAFOS_INSTRUMENTACAO
+long long Instrumentacao::bytes_da_thread() { return bytesDaThread; }
+
+void Instrumentacao::registra(int operacao, long long ns, long long b) {
+  chamadas[operacao].fetch_add(1, memory_order_relaxed);
+  nanossegundos[operacao].fetch_add(ns, memory_order_relaxed);
+  if (b != 0)
+    bytes[operacao].fetch_add(b, memory_order_relaxed);
+}
+
+void Instrumentacao::conta(int operacao) {
+  chamadas[operacao].fetch_add(1, memory_order_relaxed);
+}
+
+void Instrumentacao::conta_alocacao(int operacao, long long b) {
+  chamadas[operacao].fetch_add(1, memory_order_relaxed);
+  if (b != 0)
+    bytes[operacao].fetch_add(b, memory_order_relaxed);
+  bytesDaThread += b;
+}
+
+void Instrumentacao::registra_bytes(long long b) { bytesDaThread += b; }
+
+EstatisticasGrafo Instrumentacao::leitura() {
+  EstatisticasGrafo e;
+  e.ativa = true;
+  for (int i = 0; i < N_OPERACOES_INSTRUMENTADAS; i++) {
+    e.operacoes[i].chamadas = chamadas[i].load(memory_order_relaxed);
+    e.operacoes[i].nanossegundos = nanossegundos[i].load(memory_order_relaxed);
+    e.operacoes[i].bytes = bytes[i].load(memory_order_relaxed);
+  }
+  return e;
+}
+
+void Instrumentacao::zera() {
+  for (int i = 0; i < N_OPERACOES_INSTRUMENTADAS; i++) {
+    chamadas[i].store(0, memory_order_relaxed);
+    nanossegundos[i].store(0, memory_order_relaxed);
+    bytes[i].store(0, memory_order_relaxed);
+  }
+}
+#else
+long long Instrumentacao::bytes_da_thread() { return 0; }
+void Instrumentacao::registra(int, long long, long long) {}
+void Instrumentacao::conta(int) {}
+void Instrumentacao::conta_alocacao(int, long long) {}
+void Instrumentacao::registra_bytes(long long) {}
+
+EstatisticasGrafo Instrumentacao::leitura() {
+  EstatisticasGrafo e;
+  e.ativa = false;
+  for (int i = 0; i < N_OPERACOES_INSTRUMENTADAS; i++)
+    e.operacoes[i].chamadas = e.operacoes[i].nanossegundos =
+        e.operacoes[i].bytes = 0;
+  return e;
+}
+
+void Instrumentacao::zera() {}
+#endif
+
+const char *EstatisticasGrafo::nome(int operacao) {
+  return (operacao >= 0 && operacao < N_OPERACOES_INSTRUMENTADAS
+              ? nomesOperacoes[operacao]
+              : "?");
+}
+
+bool EstatisticasGrafo::cronometrada(int operacao) {
+  return operacao != OP_GET_PESO_ARESTA && operacao != OP_ENCONTRAR_VERTICE &&
+         operacao != OP_NO_LISTA;
+}
+
+void EstatisticasGrafo::escreve_json(ostream &saida) const {
+  saida << "{\n  \"instrumentacao\": " << (ativa ? "true" : "false")
+        << ",\n  \"operacoes\": {";
+  for (int i = 0; i < N_OPERACOES_INSTRUMENTADAS; i++) {
+    const ContadorOperacao &c = operacoes[i];
+    saida << (i > 0 ? "," : "") << "\n    \"" << nome(i)
+          << "\": {\"chamadas\": " << c.chamadas;
+    if (cronometrada(i)) {
+      char ms[32];
+      snprintf(ms, sizeof(ms), "%.3f", c.nanossegundos / 1e6);
+      saida << ", \"ms\": " << ms;
+    }
+    saida << ", \"bytes\": " << c.bytes << "}";
+  }
+  saida << "\n  }\n}\n";
+}
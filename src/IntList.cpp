@@ -1,7 +1,10 @@
 #include "../include/IntList.hpp"
+#include "../include/Instrumentacao.hpp"
 #include <cstdlib>
 
 void IntList::resize(int newCapacity) {
+  INSTRUMENTA(OP_INTLIST_RESIZE);
+  REGISTRA_BYTES((long long)newCapacity * sizeof(int));
   int *newData = new int[newCapacity];
   for (int i = 0; i < count; i++) {
     newData[i] = data[i];
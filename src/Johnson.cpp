@@ -0,0 +1,157 @@
+#include "../include/Grafo.hpp"
+#include "../include/HeapBinario.hpp"
+#include "../include/PoolThreads.hpp"
+#include <iostream>
+using namespace std;
+
+const double INF = 1e9;
+
+// Maior menor distância pelo algoritmo de Johnson: um Bellman–Ford a partir
+// de uma origem virtual calcula os potenciais h que tornam todos os pesos
+// não negativos (w'(u,v) = w(u,v) + h(u) - h(v)); em seguida um Dijkstra é
+// executado a partir de cada nó, em paralelo, guardando apenas o mais distante
+// de cada origem. A matriz n x n de distâncias nunca é montada.
+Grafo::ResultadoDistancia Grafo::distancia_johnson() const {
+  int n = get_ordem();
+
+  // Cópia das arestas em formato CSR, para que as buscas paralelas não
+  // dependam da estrutura de armazenamento
+  int *offsets = new int[n + 1];
+  offsets[0] = 0;
+  for (int v = 1; v <= n; v++) {
+    int grau = 0;
+    para_cada_vizinho(v, [n, &grau](int w, int) {
+      if (w >= 1 && w <= n)
+        grau++;
+      return true;
+    });
+    offsets[v] = offsets[v - 1] + grau;
+  }
+  int m = offsets[n];
+  int *destinos = new int[m > 0 ? m : 1];
+  double *pesos = new double[m > 0 ? m : 1];
+  for (int v = 1; v <= n; v++) {
+    int e = offsets[v - 1];
+    para_cada_vizinho(v, [n, &e, destinos, pesos](int w, int peso) {
+      if (w >= 1 && w <= n) {
+        destinos[e] = w - 1;
+        pesos[e] = peso;
+        e++;
+      }
+      return true;
+    });
+  }
+
+  // Bellman–Ford a partir de uma origem virtual ligada a todos os nós com
+  // peso 0 (equivale a começar com h = 0). Se após n rodadas ainda houver
+  // relaxamento, existe ciclo negativo.
+  double *h = new double[n];
+  for (int v = 0; v < n; v++)
+    h[v] = 0;
+  bool cicloNegativo = false;
+  for (int rodada = 0; rodada <= n; rodada++) {
+    bool mudou = false;
+    for (int u = 0; u < n; u++) {
+      for (int e = offsets[u]; e < offsets[u + 1]; e++) {
+        if (h[u] + pesos[e] < h[destinos[e]]) {
+          h[destinos[e]] = h[u] + pesos[e];
+          mudou = true;
+        }
+      }
+    }
+    if (!mudou)
+      break;
+    if (rodada == n)
+      cicloNegativo = true;
+  }
+
+  if (cicloNegativo) {
+    delete[] offsets;
+    delete[] destinos;
+    delete[] pesos;
+    delete[] h;
+    ResultadoDistancia res = {-1, -1, -1, true};
+    return res;
+  }
+
+  // Pesos repesados (todos >= 0)
+  for (int u = 0; u < n; u++) {
+    for (int e = offsets[u]; e < offsets[u + 1]; e++)
+      pesos[e] += h[u] - h[destinos[e]];
+  }
+
+  // Dijkstra a partir de cada origem. Cada tarefa usa o seu próprio heap e
+  // vetor de distâncias e processa as origens t, t + nTarefas, ...
+  double *maisLonge = new double[n]; // maior distância a partir de cada origem
+  int *noMaisLonge = new int[n];     // destino correspondente (-1 se nenhum)
+  PoolThreads &pool = PoolThreads::global();
+  int nTarefas = pool.tamanho() * 4;
+  if (nTarefas > n)
+    nTarefas = n;
+  pool.para_cada(nTarefas, [&](int t) {
+    HeapBinario heap(n);
+    double *dist = new double[n];
+    int *alcancados = new int[n];
+    for (int v = 0; v < n; v++)
+      dist[v] = INF;
+    for (int s = t; s < n; s += nTarefas) {
+      int nAlcancados = 0;
+      double melhor = -1e9;
+      int melhorNo = -1;
+      dist[s] = 0;
+      heap.insere_ou_diminui(s, 0);
+      while (!heap.vazio()) {
+        int u = heap.remove_min();
+        alcancados[nAlcancados++] = u;
+        if (u != s) {
+          // Desfaz a repesagem para obter a distância original; em caso de
+          // empate prevalece o menor id, como na varredura do Floyd–Warshall
+          double real = dist[u] - h[s] + h[u];
+          if (real > melhor || (real == melhor && u < melhorNo)) {
+            melhor = real;
+            melhorNo = u;
+          }
+        }
+        for (int e = offsets[u]; e < offsets[u + 1]; e++) {
+          int w = destinos[e];
+          double nova = dist[u] + pesos[e];
+          if (nova < dist[w]) {
+            dist[w] = nova;
+            heap.insere_ou_diminui(w, nova);
+          }
+        }
+      }
+      for (int i = 0; i < nAlcancados; i++)
+        dist[alcancados[i]] = INF;
+      maisLonge[s] = melhor;
+      noMaisLonge[s] = melhorNo;
+    }
+    delete[] dist;
+    delete[] alcancados;
+  });
+
+  // Redução: maior distância entre todas as origens (menor origem no empate)
+  double maxDist = -1e9;
+  int bestI = -1, bestJ = -1;
+  for (int s = 0; s < n; s++) {
+    if (noMaisLonge[s] >= 0 && maisLonge[s] > maxDist) {
+      maxDist = maisLonge[s];
+      bestI = s;
+      bestJ = noMaisLonge[s];
+    }
+  }
+
+  delete[] offsets;
+  delete[] destinos;
+  delete[] pesos;
+  delete[] h;
+  delete[] maisLonge;
+  delete[] noMaisLonge;
+
+  ResultadoDistancia res;
+  res.no1 = (bestI != -1 ? bestI + 1 : -1);
+  res.no2 = (bestJ != -1 ? bestJ + 1 : -1);
+  res.distancia = maxDist;
+  res.cicloNegativo = false;
+  return res;
+}
@@ -0,0 +1,89 @@
+#include "../include/PoolThreads.hpp"
+
+PoolThreads::PoolThreads(int nThreads)
+    : trabalhadores(nullptr), nTrabalhadores(0), atual(nullptr), total(0),
+      proxima(0), ativos(0), geracao(0), encerrar(false) {
+  if (nThreads <= 0)
+    nThreads = (int)std::thread::hardware_concurrency();
+  if (nThreads <= 0)
+    nThreads = 1;
+  nTrabalhadores = nThreads - 1;
+  if (nTrabalhadores > 0) {
+    trabalhadores = new std::thread[nTrabalhadores];
+    for (int i = 0; i < nTrabalhadores; i++)
+      trabalhadores[i] = std::thread(&PoolThreads::trabalha, this);
+  }
+}
+
+PoolThreads::~PoolThreads() {
+  {
+    std::lock_guard<std::mutex> trava(mtx);
+    encerrar = true;
+  }
+  cvInicio.notify_all();
+  for (int i = 0; i < nTrabalhadores; i++)
+    trabalhadores[i].join();
+  delete[] trabalhadores;
+}
+
+PoolThreads &PoolThreads::global() {
+  static PoolThreads pool;
+  return pool;
+}
+
+void PoolThreads::consome(Tarefa &tarefa, int nTarefas) {
+  int i;
+  while ((i = proxima.fetch_add(1)) < nTarefas)
+    tarefa.executa(i);
+}
+
+void PoolThreads::executa_lote(int nTarefas, Tarefa &tarefa) {
+  if (nTarefas <= 0)
+    return;
+  // Sem trabalhadores, com uma única tarefa ou com o pool ocupado por outro
+  // lote, executa tudo na thread chamadora
+  std::unique_lock<std::mutex> lote(mtxLote, std::try_to_lock);
+  if (nTrabalhadores == 0 || nTarefas == 1 || !lote.owns_lock()) {
+    for (int i = 0; i < nTarefas; i++)
+      tarefa.executa(i);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> trava(mtx);
+    atual = &tarefa;
+    total = nTarefas;
+    proxima.store(0);
+    ativos = nTrabalhadores;
+    geracao++;
+  }
+  cvInicio.notify_all();
+  consome(tarefa, nTarefas);
+
+  std::unique_lock<std::mutex> trava(mtx);
+  cvFim.wait(trava, [this]() { return ativos == 0; });
+  atual = nullptr;
+}
+
+void PoolThreads::trabalha() {
+  long long vista = 0;
+  for (;;) {
+    Tarefa *tarefa;
+    int nTarefas;
+    {
+      std::unique_lock<std::mutex> trava(mtx);
+      cvInicio.wait(trava, [&]() { return encerrar || geracao != vista; });
+      if (encerrar)
+        return;
+      vista = geracao;
+      tarefa = atual;
+      nTarefas = total;
+    }
+    consome(*tarefa, nTarefas);
+    {
+      std::lock_guard<std::mutex> trava(mtx);
+      if (--ativos == 0)
+        cvFim.notify_one();
+    }
+  }
+}
@@ -0,0 +1,448 @@
+#include "../include/ServidorConsultas.hpp"
+#include <cerrno>
+#include <climits>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+// Tamanho do buffer de leitura, que também limita o comprimento das linhas
+static const int TAMANHO_BUFFER = 1 << 16;
+// Máximo de palavras por comando (o nome e até quatro argumentos)
+static const int MAX_PALAVRAS = 5;
+
+ServidorConsultas::ServidorConsultas(Grafo &grafo)
+    : grafo(grafo), tipos(nullptr), nPendentes(0), capPendentes(0),
+      ordemPrevista(grafo.get_ordem()), resposta(nullptr), tamResposta(0),
+      capResposta(0) {
+  for (int i = 0; i < 3; i++)
+    args[i] = nullptr;
+}
+
+ServidorConsultas::~ServidorConsultas() {
+  delete[] tipos;
+  for (int i = 0; i < 3; i++)
+    delete[] args[i];
+  delete[] resposta;
+}
+
+static long le_disponivel(int entrada, char *destino, int maximo) {
+#if defined(_WIN32)
+  return _read(entrada, destino, maximo);
+#else
+  ssize_t n;
+  do
+    n = read(entrada, destino, maximo);
+  while (n < 0 && errno == EINTR);
+  return (long)n;
+#endif
+}
+
+static long escreve(int saida, const char *origem, size_t n) {
+#if defined(_WIN32)
+  return _write(saida, origem, (unsigned)n);
+#else
+  ssize_t r;
+  do
+    r = write(saida, origem, n);
+  while (r < 0 && errno == EINTR);
+  return (long)r;
+#endif
+}
+
+// Converte uma palavra inteira em int; false se não for um número válido
+static bool le_inteiro(const char *palavra, int &valor) {
+  char *fim;
+  errno = 0;
+  long v = strtol(palavra, &fim, 10);
+  if (fim == palavra || *fim != '\0' || errno == ERANGE || v < INT_MIN ||
+      v > INT_MAX)
+    return false;
+  valor = (int)v;
+  return true;
+}
+
+void ServidorConsultas::enfileira(TipoAlteracao tipo, int a, int b, int c) {
+  if (nPendentes == capPendentes) {
+    int novaCap = (capPendentes == 0 ? 64 : 2 * capPendentes);
+    int *novosTipos = new int[novaCap];
+    if (nPendentes > 0)
+      memcpy(novosTipos, tipos, nPendentes * sizeof(int));
+    delete[] tipos;
+    tipos = novosTipos;
+    for (int i = 0; i < 3; i++) {
+      int *novos = new int[novaCap];
+      if (nPendentes > 0)
+        memcpy(novos, args[i], nPendentes * sizeof(int));
+      delete[] args[i];
+      args[i] = novos;
+    }
+    capPendentes = novaCap;
+  }
+  tipos[nPendentes] = tipo;
+  args[0][nPendentes] = a;
+  args[1][nPendentes] = b;
+  args[2][nPendentes] = c;
+  nPendentes++;
+}
+
+// Cada sequência de alterações consecutivas do mesmo tipo vira uma chamada;
+// os vetores de argumentos já estão no formato das operações em lote
+void ServidorConsultas::aplica_pendentes() {
+  int i = 0;
+  while (i < nPendentes) {
+    int j = i + 1;
+    while (j < nPendentes && tipos[j] == tipos[i])
+      j++;
+    int n = j - i;
+    int *a = args[0] + i;
+    int *b = args[1] + i;
+    int *c = args[2] + i;
+    switch (tipos[i]) {
+    case NOVA_ARESTA:
+      if (n == 1)
+        grafo.nova_aresta(a[0], b[0], c[0]);
+      else
+        grafo.inserir_arestas_lote(a, b, c, n);
+      break;
+    case DELETA_NO:
+      if (n == 1)
+        grafo.deleta_no(a[0]);
+      else
+        grafo.deleta_nos(a, n);
+      break;
+    case DELETA_ARESTA:
+      if (n == 1)
+        grafo.deleta_aresta(a[0], b[0]);
+      else
+        grafo.deleta_arestas(a, b, n);
+      break;
+    default:
+      for (int k = 0; k < n; k++)
+        grafo.altera_peso_aresta(a[k], b[k], c[k]);
+      break;
+    }
+    i = j;
+  }
+  nPendentes = 0;
+  ordemPrevista = grafo.get_ordem();
+}
+
+void ServidorConsultas::responde(const char *texto) {
+  size_t n = strlen(texto);
+  if (tamResposta + n > capResposta) {
+    size_t novaCap = (capResposta == 0 ? 4096 : 2 * capResposta);
+    while (novaCap < tamResposta + n)
+      novaCap *= 2;
+    char *novo = new char[novaCap];
+    if (tamResposta > 0)
+      memcpy(novo, resposta, tamResposta);
+    delete[] resposta;
+    resposta = novo;
+    capResposta = novaCap;
+  }
+  memcpy(resposta + tamResposta, texto, n);
+  tamResposta += n;
+}
+
+void ServidorConsultas::responde_inteiro(long long valor) {
+  char texto[24];
+  snprintf(texto, sizeof(texto), "%lld", valor);
+  responde(texto);
+}
+
+bool ServidorConsultas::envia(int saida) {
+  aplica_pendentes();
+  size_t enviados = 0;
+  while (enviados < tamResposta) {
+    long n = escreve(saida, resposta + enviados, tamResposta - enviados);
+    if (n <= 0) {
+      tamResposta = 0;
+      return false;
+    }
+    enviados += n;
+  }
+  tamResposta = 0;
+  return true;
+}
+
+bool ServidorConsultas::executa(char *linha, Fim &motivo) {
+  // Separa as palavras no próprio buffer
+  char *palavras[MAX_PALAVRAS];
+  int n = 0;
+  char *p = linha;
+  while (true) {
+    while (*p == ' ' || *p == '\t' || *p == '\r')
+      p++;
+    if (*p == '\0' || *p == '#')
+      break;
+    if (n == MAX_PALAVRAS) {
+      responde("erro argumentos demais\n");
+      return true;
+    }
+    palavras[n++] = p;
+    while (*p != '\0' && *p != ' ' && *p != '\t' && *p != '\r')
+      p++;
+    if (*p != '\0')
+      *p++ = '\0';
+  }
+  if (n == 0)
+    return true;
+
+  const char *comando = palavras[0];
+  int valores[MAX_PALAVRAS - 1];
+  for (int i = 1; i < n; i++) {
+    if (!le_inteiro(palavras[i], valores[i - 1])) {
+      responde("erro argumento invalido: ");
+      responde(palavras[i]);
+      responde("\n");
+      return true;
+    }
+  }
+  int nArgs = n - 1;
+  // Vértices das alterações: ids do grafo após as alterações pendentes
+  int nVertices = 0;
+  if (strcmp(comando, "deleta_no") == 0)
+    nVertices = 1;
+  else if (strcmp(comando, "nova_aresta") == 0 ||
+           strcmp(comando, "deleta_aresta") == 0 ||
+           strcmp(comando, "altera_peso") == 0)
+    nVertices = 2;
+  for (int i = 0; i < nVertices && i < nArgs; i++) {
+    if (valores[i] < 1 || valores[i] > ordemPrevista) {
+      responde("erro vertice inexistente: ");
+      responde_inteiro(valores[i]);
+      responde("\n");
+      return true;
+    }
+  }
+
+  // Alterações
+  if (strcmp(comando, "novo_no") == 0) {
+    if (nArgs > 1) {
+      responde("erro uso: novo_no [peso]\n");
+      return true;
+    }
+    aplica_pendentes();
+    grafo.novo_no(nArgs == 1 ? valores[0] : 0);
+    ordemPrevista = grafo.get_ordem();
+    responde("ok ");
+    responde_inteiro(grafo.get_ordem());
+    responde("\n");
+    return true;
+  }
+  if (strcmp(comando, "nova_aresta") == 0) {
+    if (nArgs < 2 || nArgs > 3)
+      responde("erro uso: nova_aresta origem destino [peso]\n");
+    else {
+      enfileira(NOVA_ARESTA, valores[0], valores[1],
+                nArgs == 3 ? valores[2] : 1);
+      responde("ok\n");
+    }
+    return true;
+  }
+  if (strcmp(comando, "deleta_no") == 0) {
+    if (nArgs != 1)
+      responde("erro uso: deleta_no id\n");
+    else {
+      enfileira(DELETA_NO, valores[0], 0, 0);
+      ordemPrevista--;
+      responde("ok\n");
+    }
+    return true;
+  }
+  if (strcmp(comando, "deleta_aresta") == 0) {
+    if (nArgs != 2)
+      responde("erro uso: deleta_aresta origem destino\n");
+    else {
+      enfileira(DELETA_ARESTA, valores[0], valores[1], 0);
+      responde("ok\n");
+    }
+    return true;
+  }
+  if (strcmp(comando, "altera_peso") == 0) {
+    if (nArgs != 3)
+      responde("erro uso: altera_peso origem destino peso\n");
+    else {
+      enfileira(ALTERA_PESO, valores[0], valores[1], valores[2]);
+      responde("ok\n");
+    }
+    return true;
+  }
+
+  // Controle
+  if (strcmp(comando, "sair") == 0 || strcmp(comando, "encerrar") == 0) {
+    responde("ok\n");
+    motivo = (comando[0] == 's' ? FIM_SAIR : FIM_ENCERRAR);
+    return false;
+  }
+
+  // Consultas: veem todas as alterações anteriores
+  aplica_pendentes();
+  if (strcmp(comando, "ordem") == 0 && nArgs == 0) {
+    responde_inteiro(grafo.get_ordem());
+    responde("\n");
+  } else if (strcmp(comando, "arestas") == 0 && nArgs == 0) {
+    responde_inteiro(grafo.get_num_arestas());
+    responde("\n");
+  } else if (strcmp(comando, "grau") == 0 && nArgs == 0) {
+    responde_inteiro(grafo.get_grau());
+    responde("\n");
+  } else if ((strcmp(comando, "grau") == 0 && nArgs == 1) ||
+             (strcmp(comando, "vizinhos") == 0 && nArgs == 1)) {
+    int v = valores[0];
+    if (v < 1 || v > grafo.get_ordem()) {
+      responde("erro vertice inexistente: ");
+      responde_inteiro(v);
+    } else if (comando[0] == 'g') {
+      responde_inteiro(grafo.get_grau_saida(v));
+    } else {
+      IntList vizinhos = grafo.get_vizinhos(v);
+      responde_inteiro(vizinhos.size());
+      for (int i = 0; i < vizinhos.size(); i++) {
+        responde(" ");
+        responde_inteiro(vizinhos.get(i));
+      }
+    }
+    responde("\n");
+  } else if (strcmp(comando, "componentes") == 0 && nArgs == 0) {
+    responde_inteiro(grafo.n_conexo());
+    responde("\n");
+  } else if (strcmp(comando, "completo") == 0 && nArgs == 0) {
+    responde(grafo.eh_completo() ? "sim\n" : "nao\n");
+  } else if (strcmp(comando, "diametro") == 0 && nArgs == 0) {
+    Grafo::ResultadoDistancia res = grafo.calculaMaiorMenorDistancia();
+    if (res.cicloNegativo) {
+      responde("indefinida\n");
+    } else {
+      char texto[80];
+      snprintf(texto, sizeof(texto), "%d %d %.15g\n", res.no1, res.no2,
+               res.distancia);
+      responde(texto);
+    }
+  } else {
+    responde("erro comando invalido: ");
+    responde(comando);
+    responde("\n");
+  }
+  return true;
+}
+
+// Lê blocos da entrada e executa as linhas completas de cada bloco; as
+// respostas do bloco são enviadas juntas, depois de aplicar as alterações
+// pendentes, antes da leitura seguinte. Uma linha maior que o buffer é
+// descartada até a quebra e respondida com erro.
+ServidorConsultas::Fim ServidorConsultas::atende(int entrada, int saida) {
+  char *buffer = new char[TAMANHO_BUFFER + 1];
+  int usados = 0;
+  bool descartando = false;
+  Fim motivo = FIM_ENTRADA;
+  bool continua = true;
+  while (continua) {
+    long lidos =
+        le_disponivel(entrada, buffer + usados, TAMANHO_BUFFER - usados);
+    if (lidos < 0) {
+      cerr << "Erro ao ler os comandos: " << strerror(errno) << "\n";
+      break;
+    }
+    if (lidos == 0) {
+      // Fim da entrada: a última linha pode não ter quebra
+      if (descartando) {
+        responde("erro linha muito longa\n");
+      } else if (usados > 0) {
+        buffer[usados] = '\0';
+        executa(buffer, motivo);
+      }
+      break;
+    }
+    int fim = usados + (int)lidos;
+    int inicio = 0;
+    for (int i = usados; i < fim && continua; i++) {
+      if (buffer[i] != '\n')
+        continue;
+      buffer[i] = '\0';
+      if (descartando) {
+        responde("erro linha muito longa\n");
+        descartando = false;
+      } else {
+        continua = executa(buffer + inicio, motivo);
+      }
+      inicio = i + 1;
+    }
+    // Guarda o início da linha incompleta
+    usados = fim - inicio;
+    memmove(buffer, buffer + inicio, usados);
+    if (usados == TAMANHO_BUFFER || descartando) {
+      descartando = true;
+      usados = 0;
+    }
+    if (!envia(saida))
+      continua = false;
+  }
+  envia(saida);
+  delete[] buffer;
+  return motivo;
+}
+
+bool ServidorConsultas::escuta(const string &caminho) {
+#if defined(_WIN32)
+  cerr << "Erro: sockets Unix não são suportados neste sistema ("
+       << caminho << ").\n";
+  return false;
+#else
+  struct sockaddr_un endereco;
+  memset(&endereco, 0, sizeof(endereco));
+  endereco.sun_family = AF_UNIX;
+  if (caminho.size() >= sizeof(endereco.sun_path)) {
+    cerr << "Erro: caminho do socket longo demais: " << caminho << "\n";
+    return false;
+  }
+  memcpy(endereco.sun_path, caminho.c_str(), caminho.size());
+
+  int servidor = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (servidor < 0) {
+    cerr << "Erro ao criar o socket: " << strerror(errno) << "\n";
+    return false;
+  }
+  // Um socket deixado por uma execução anterior impediria o bind
+  unlink(caminho.c_str());
+  if (bind(servidor, (struct sockaddr *)&endereco, sizeof(endereco)) < 0 ||
+      listen(servidor, 16) < 0) {
+    cerr << "Erro ao escutar em " << caminho << ": " << strerror(errno)
+         << "\n";
+    close(servidor);
+    return false;
+  }
+  // Um cliente que fecha a conexão antes de ler as respostas não deve
+  // encerrar o servidor
+  signal(SIGPIPE, SIG_IGN);
+
+  bool ok = true;
+  while (true) {
+    int cliente = accept(servidor, nullptr, nullptr);
+    if (cliente < 0) {
+      if (errno == EINTR || errno == ECONNABORTED)
+        continue;
+      cerr << "Erro ao aceitar conexão: " << strerror(errno) << "\n";
+      ok = false;
+      break;
+    }
+    Fim motivo = atende(cliente, cliente);
+    close(cliente);
+    if (motivo == FIM_ENCERRAR)
+      break;
+  }
+  close(servidor);
+  unlink(caminho.c_str());
+  return ok;
+#endif
+}
@@ -0,0 +1,69 @@
+#include "../include/UniaoBusca.hpp"
+
+UniaoBusca::UniaoBusca()
+    : pai(nullptr), rank(nullptr), n(0), capacidade(0), nComponentes(0) {}
+
+UniaoBusca::~UniaoBusca() {
+  delete[] pai;
+  delete[] rank;
+}
+
+void UniaoBusca::resize(int novaCapacidade) {
+  int *novoPai = new int[novaCapacidade];
+  int *novoRank = new int[novaCapacidade];
+  for (int i = 0; i < n; i++) {
+    novoPai[i] = pai[i];
+    novoRank[i] = rank[i];
+  }
+  delete[] pai;
+  delete[] rank;
+  pai = novoPai;
+  rank = novoRank;
+  capacidade = novaCapacidade;
+}
+
+void UniaoBusca::reinicia(int total) {
+  if (total > capacidade)
+    resize(total);
+  n = total;
+  nComponentes = total;
+  for (int i = 0; i < n; i++) {
+    pai[i] = i;
+    rank[i] = 0;
+  }
+}
+
+int UniaoBusca::adiciona() {
+  if (n == capacidade)
+    resize(capacidade == 0 ? 10 : capacidade * 2);
+  pai[n] = n;
+  rank[n] = 0;
+  nComponentes++;
+  return n++;
+}
+
+int UniaoBusca::encontra(int x) {
+  // Compressão por divisão de caminho (path halving), sem recursão
+  while (pai[x] != x) {
+    pai[x] = pai[pai[x]];
+    x = pai[x];
+  }
+  return x;
+}
+
+bool UniaoBusca::une(int a, int b) {
+  int ra = encontra(a);
+  int rb = encontra(b);
+  if (ra == rb)
+    return false;
+  if (rank[ra] < rank[rb]) {
+    int t = ra;
+    ra = rb;
+    rb = t;
+  }
+  pai[rb] = ra;
+  if (rank[ra] == rank[rb])
+    rank[ra]++;
+  nComponentes--;
+  return true;
+}